@@ -47,6 +47,21 @@
 static uint32_t crc32_tab[256];
 static uint32_t crc32_context = 0xFFFFFFFFUL;
 
+/*
+ * With CSMITH_FAST_CRC the checksum is computed slicing-by-8 (slicing-by-4
+ * without long long): crc32_slices[k][b] is the CRC of byte b followed by k
+ * zero bytes, so a whole value is folded in with one lookup per byte and no
+ * dependency between them. The checksums are the same as byte by byte.
+ */
+#ifdef CSMITH_FAST_CRC
+#if defined(__SPLAT__) || defined(NO_LONGLONG)
+#define CRC32_SLICES 4
+#else
+#define CRC32_SLICES 8
+#endif
+static uint32_t crc32_slices[CRC32_SLICES][256];
+#endif
+
 static void 
 crc32_gentab (void)
 {
@@ -65,6 +80,15 @@ crc32_gentab (void)
 		}
 		crc32_tab[i] = crc;
 	}
+#ifdef CSMITH_FAST_CRC
+	for (i = 0; i < 256; i++) {
+		crc32_slices[0][i] = crc32_tab[i];
+		for (j = 1; j < CRC32_SLICES; j++) {
+			crc = crc32_slices[j - 1][i];
+			crc32_slices[j][i] = (crc >> 8) ^ crc32_tab[crc & 0xFF];
+		}
+	}
+#endif
 }
 
 static void 
@@ -75,6 +99,18 @@ crc32_byte (uint8_t b) {
 }
 
 #if defined(__SPLAT__) || defined(NO_LONGLONG)
+#ifdef CSMITH_FAST_CRC
+static void 
+crc32_8bytes (uint32_t val)
+{
+	uint32_t crc = crc32_context ^ val;
+	crc32_context =
+		crc32_slices[3][crc & 0xFF] ^
+		crc32_slices[2][(crc >> 8) & 0xFF] ^
+		crc32_slices[1][(crc >> 16) & 0xFF] ^
+		crc32_slices[0][crc >> 24];
+}
+#else
 static void 
 crc32_8bytes (uint32_t val)
 {
@@ -83,6 +119,7 @@ crc32_8bytes (uint32_t val)
 	crc32_byte ((val>>16) & 0xff);
 	crc32_byte ((val>>24) & 0xff);
 }
+#endif
 
 static void 
 transparent_crc (uint32_t val, char* vname, int flag)
@@ -93,6 +130,23 @@ transparent_crc (uint32_t val, char* vname, int flag)
 	}
 }
 #else
+#ifdef CSMITH_FAST_CRC
+static void 
+crc32_8bytes (uint64_t val)
+{
+	uint32_t crc = crc32_context ^ (uint32_t)val;
+	uint32_t hi = (uint32_t)(val >> 32);
+	crc32_context =
+		crc32_slices[7][crc & 0xFF] ^
+		crc32_slices[6][(crc >> 8) & 0xFF] ^
+		crc32_slices[5][(crc >> 16) & 0xFF] ^
+		crc32_slices[4][crc >> 24] ^
+		crc32_slices[3][hi & 0xFF] ^
+		crc32_slices[2][(hi >> 8) & 0xFF] ^
+		crc32_slices[1][(hi >> 16) & 0xFF] ^
+		crc32_slices[0][hi >> 24];
+}
+#else
 static void 
 crc32_8bytes (uint64_t val)
 {
@@ -105,6 +159,7 @@ crc32_8bytes (uint64_t val)
 	crc32_byte ((val>>48) & 0xff);
 	crc32_byte ((val>>56) & 0xff);
 }
+#endif
 
 static void 
 transparent_crc (uint64_t val, char* vname, int flag)
@@ -120,8 +175,25 @@ transparent_crc (uint64_t val, char* vname, int flag)
 static void 
 transparent_crc_bytes (char *ptr, int nbytes, char* vname, int flag)
 {
-    int i;
-    for (i=0; i<nbytes; i++) {
+    int i = 0;
+#ifdef CSMITH_FAST_CRC
+	/* the bytes in memory order, as the low byte first of a value */
+	const unsigned char *p = (const unsigned char *)ptr;
+#if defined(__SPLAT__) || defined(NO_LONGLONG)
+	for (; i + 4 <= nbytes; i += 4) {
+		crc32_8bytes((uint32_t)p[i] | ((uint32_t)p[i+1] << 8) |
+					 ((uint32_t)p[i+2] << 16) | ((uint32_t)p[i+3] << 24));
+	}
+#else
+	for (; i + 8 <= nbytes; i += 8) {
+		crc32_8bytes((uint64_t)p[i] | ((uint64_t)p[i+1] << 8) |
+					 ((uint64_t)p[i+2] << 16) | ((uint64_t)p[i+3] << 24) |
+					 ((uint64_t)p[i+4] << 32) | ((uint64_t)p[i+5] << 40) |
+					 ((uint64_t)p[i+6] << 48) | ((uint64_t)p[i+7] << 56));
+	}
+#endif
+#endif
+    for (; i<nbytes; i++) {
         crc32_byte(ptr[i]);
     }
 	if (flag) {
@@ -129,6 +201,40 @@ transparent_crc_bytes (char *ptr, int nbytes, char* vname, int flag)
 	}
 }
 
+#ifdef CSMITH_BLOCK_HASH
+/*
+ * transparent_crc over the <n> items of type <type> starting at <ptr>,
+ * read with memcpy so that a whole array, or an array of packed structs
+ * of that type, can be passed. The checksum is reported once, after the
+ * last item.
+ */
+#define CSMITH_CRC_BLOCK(type) \
+static void \
+transparent_crc_block_##type (const void *ptr, size_t n, char* vname, int flag) \
+{ \
+	const unsigned char *p = (const unsigned char *)ptr; \
+	type v; \
+	size_t i; \
+	for (i = 0; i < n; i++) { \
+		memcpy(&v, p + i * sizeof(v), sizeof(v)); \
+		transparent_crc(v, vname, flag && i + 1 == n); \
+	} \
+}
+
+CSMITH_CRC_BLOCK(int8_t)
+CSMITH_CRC_BLOCK(uint8_t)
+CSMITH_CRC_BLOCK(int16_t)
+CSMITH_CRC_BLOCK(uint16_t)
+CSMITH_CRC_BLOCK(int32_t)
+CSMITH_CRC_BLOCK(uint32_t)
+#if !defined(__SPLAT__) && !defined(NO_LONGLONG)
+CSMITH_CRC_BLOCK(int64_t)
+CSMITH_CRC_BLOCK(uint64_t)
+#endif
+
+#undef CSMITH_CRC_BLOCK
+#endif
+
 /*****************************************************************************/
 
 #endif
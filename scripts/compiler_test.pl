@@ -41,6 +41,9 @@ my $MIN_PROGRAM_SIZE = 8000;
 # kill Csmith after this many seconds
 my $CSMITH_TIMEOUT = 90; 
 
+# let Csmith finish the program early, well before it would be killed
+my $CSMITH_BUDGET = $CSMITH_TIMEOUT / 2;
+
 # kill a compiler after this many seconds
 my $COMPILER_TIMEOUT = 120;
 
@@ -237,7 +240,7 @@ sub test_one ($) {
     # run Csmith until generate a big enough program
     while (1) {
         unlink $cfile;
-        my $cmd = "$CSMITH_HOME/src/csmith $CSMITH_USER_OPTIONS --output $cfile";
+        my $cmd = "$CSMITH_HOME/src/csmith $CSMITH_USER_OPTIONS --budget-time $CSMITH_BUDGET --target-size $MIN_PROGRAM_SIZE: --output $cfile";
         my ($res, $exitcode) = runit($cmd, $CSMITH_TIMEOUT,  "csmith.out"); 
         # print "after run csmith: $res, $exitcode\n";
 	
@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+##
+## Copyright (c) 2026 The University of Utah
+## All rights reserved.
+##
+## This file is part of `csmith', a random generator of C programs.
+##
+## Redistribution and use in source and binary forms, with or without
+## modification, are permitted provided that the following conditions are met:
+##
+##   * Redistributions of source code must retain the above copyright notice,
+##     this list of conditions and the following disclaimer.
+##
+##   * Redistributions in binary form must reproduce the above copyright
+##     notice, this list of conditions and the following disclaimer in the
+##     documentation and/or other materials provided with the distribution.
+##
+## THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+## AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+## IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+## ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+## LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+## CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+## SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+## INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+## CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+## ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+## POSSIBILITY OF SUCH DAMAGE.
+
+###############################################################################
+
+# Measures the generation throughput of csmith: generates a fixed corpus of
+# seeds under a few representative option sets, one process per seed, and
+# reports programs/sec, bytes/sec, peak RSS and per-seed latency percentiles
+# as JSON. Run it through the `csmith-bench' build target, or directly:
+#
+#   csmith_bench.py --csmith src/csmith --seeds 1..20 --output bench.json
+
+import argparse
+import json
+import os
+import platform
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+CONFIGS = [
+    ("default",    []),
+    ("no-pointers", ["--no-pointers"]),
+    ("many-funcs", ["--max-funcs", "30"]),
+    ("deep-blocks", ["--max-block-depth", "7"]),
+    ("paranoid",   ["--paranoid"]),
+    ("concise",    ["--concise"]),
+]
+
+def parse_seeds(s):
+    if ".." in s:
+        lo, hi = s.split("..", 1)
+        return list(range(int(lo), int(hi) + 1))
+    return [int(x) for x in s.split(",")]
+
+def percentile(sorted_vals, p):
+    if not sorted_vals:
+        return 0.0
+    k = (len(sorted_vals) - 1) * p / 100.0
+    lo = int(k)
+    hi = min(lo + 1, len(sorted_vals) - 1)
+    return sorted_vals[lo] + (sorted_vals[hi] - sorted_vals[lo]) * (k - lo)
+
+def run_one(csmith, opts, seed, timeout, out):
+    """Generate one program into `out'. Returns (status, seconds, bytes, maxrss_kb)."""
+    out.seek(0)
+    out.truncate()
+    start = time.monotonic()
+    p = subprocess.Popen([csmith, "-s", str(seed)] + opts,
+                         stdout=out, stderr=subprocess.DEVNULL)
+    timer = threading.Timer(timeout, p.kill)
+    timer.start()
+    # reap the child ourselves to get its resource usage
+    _, status, usage = os.wait4(p.pid, 0)
+    elapsed = time.monotonic() - start
+    timer.cancel()
+    p.returncode = status
+    if os.WIFSIGNALED(status) and os.WTERMSIG(status) == 9 and elapsed >= timeout:
+        result = "timeout"
+    elif os.WIFEXITED(status) and os.WEXITSTATUS(status) == 0:
+        result = "ok"
+    else:
+        result = "error"
+    size = os.fstat(out.fileno()).st_size
+    # ru_maxrss is in kilobytes on Linux, in bytes on macOS
+    rss = usage.ru_maxrss // 1024 if sys.platform == "darwin" else usage.ru_maxrss
+    return result, elapsed, size, rss
+
+def bench_config(csmith, name, opts, seeds, timeout):
+    latencies = []
+    total_time = 0.0
+    total_bytes = 0
+    peak_rss = 0
+    failed = []
+    with tempfile.TemporaryFile() as out:
+        for seed in seeds:
+            result, elapsed, size, rss = run_one(csmith, opts, seed, timeout, out)
+            peak_rss = max(peak_rss, rss)
+            if result != "ok":
+                failed.append({"seed": seed, "result": result})
+                continue
+            latencies.append(elapsed)
+            total_time += elapsed
+            total_bytes += size
+    latencies.sort()
+    ms = lambda x: round(x * 1000, 3)
+    return {
+        "config": name,
+        "options": opts,
+        "programs": len(latencies),
+        "failed": failed,
+        "seconds": round(total_time, 3),
+        "programs_per_sec": round(len(latencies) / total_time, 3) if total_time else 0.0,
+        "bytes_per_sec": round(total_bytes / total_time, 1) if total_time else 0.0,
+        "total_bytes": total_bytes,
+        "peak_rss_kb": peak_rss,
+        "latency_ms": {
+            "min": ms(latencies[0]) if latencies else 0.0,
+            "p50": ms(percentile(latencies, 50)),
+            "p90": ms(percentile(latencies, 90)),
+            "p99": ms(percentile(latencies, 99)),
+            "max": ms(latencies[-1]) if latencies else 0.0,
+        },
+    }
+
+def main():
+    parser = argparse.ArgumentParser(description="Measure csmith generation throughput.")
+    parser.add_argument("--csmith", default="csmith", help="the csmith binary")
+    parser.add_argument("--seeds", default="1..20",
+                        help="seeds to generate, as A..B or a comma separated list (default 1..20)")
+    parser.add_argument("--config", action="append",
+                        choices=[name for name, _ in CONFIGS],
+                        help="run only this option set (may be repeated)")
+    parser.add_argument("--timeout", type=float, default=60,
+                        help="seconds before a seed is given up (default 60)")
+    parser.add_argument("--output", help="write the JSON report here instead of stdout")
+    args = parser.parse_args()
+
+    seeds = parse_seeds(args.seeds)
+    version = subprocess.run([args.csmith, "--version"], stdout=subprocess.PIPE,
+                             stderr=subprocess.DEVNULL, universal_newlines=True).stdout
+    report = {
+        "csmith": args.csmith,
+        "version": version.strip().splitlines(),
+        "host": platform.node(),
+        "machine": platform.machine(),
+        "seeds": args.seeds,
+        "results": [],
+    }
+    for name, opts in CONFIGS:
+        if args.config and name not in args.config:
+            continue
+        r = bench_config(args.csmith, name, opts, seeds, args.timeout)
+        report["results"].append(r)
+        sys.stderr.write("%-12s %8.2f programs/s %12.0f bytes/s  p50 %8.1f ms  p99 %8.1f ms  rss %7d KB%s\n" % (
+            name, r["programs_per_sec"], r["bytes_per_sec"], r["latency_ms"]["p50"],
+            r["latency_ms"]["p99"], r["peak_rss_kb"],
+            "  (%d failed)" % len(r["failed"]) if r["failed"] else ""))
+
+    text = json.dumps(report, indent=2) + "\n"
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+if __name__ == "__main__":
+    main()
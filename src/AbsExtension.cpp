@@ -103,9 +103,9 @@ AbsExtension::default_output_definitions(ostream &out, std::vector<ExtensionValu
 		out << " " << (*i)->get_name();
 		if (init_flag)
 			out << " = 0";
-		out << ";" << endl;
+		out << ";" << '\n';
 	}
-	out << endl;
+	out << '\n';
 }
 
 void
@@ -114,7 +114,7 @@ AbsExtension::OutputFirstFunInvocation(std::ostream &out, FunctionInvocation *in
 	assert(invoke);
 	out << "    ";
         invoke->Output(out);
-        out << ";" << endl;
+        out << ";" << '\n';
 }
 
 AbsExtension::AbsExtension()
@@ -42,7 +42,7 @@
 
 using namespace std;
 
-AbsProgramGenerator *AbsProgramGenerator::current_generator_ = NULL;
+thread_local AbsProgramGenerator *AbsProgramGenerator::current_generator_ = NULL;
 
 OutputMgr *
 AbsProgramGenerator::GetOutputMgr()
@@ -56,7 +56,7 @@ protected:
 	virtual void initialize() = 0;
 
 private:
-	static AbsProgramGenerator *current_generator_;
+	static thread_local AbsProgramGenerator *current_generator_;
 
 	static OutputMgr *getmgr(AbsProgramGenerator *gen);
 };
@@ -37,6 +37,7 @@
 #include <cstdlib>
 #include <iostream>
 
+#include "CGOptions.h"
 #include "DefaultRndNumGenerator.h"
 #include "DFSRndNumGenerator.h"
 
@@ -44,11 +45,52 @@ using namespace std;
 
 #ifndef HAVE_LRAND48
 extern "C" {
-	extern void srand48(long seed);
-	extern long lrand48(void);
+	extern long nrand48(unsigned short xseed[3]);
 }
 #endif
 
+// The state of the lrand48 sequence. We keep our own copy and step it with
+// nrand48, instead of using the hidden state of lrand48, so that each thread
+// of --jobs has its own sequence.
+static thread_local unsigned short rand48_state[3];
+
+// --rng xoshiro256: one xoshiro256** state per stream
+static thread_local bool use_xoshiro = false;
+static thread_local RandomStream current_stream = rsDefault;
+static thread_local unsigned INT64 xoshiro_state[MAX_RANDOM_STREAM][4];
+
+static inline unsigned INT64
+rotl(const unsigned INT64 x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+static unsigned INT64
+xoshiro_next(unsigned INT64 *s)
+{
+	const unsigned INT64 result = rotl(s[1] * 5, 7) * 9;
+	const unsigned INT64 t = s[1] << 17;
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rotl(s[3], 45);
+	return result;
+}
+
+/*
+ * splitmix64, the recommended way to fill the xoshiro state from one seed
+ */
+static unsigned INT64
+splitmix_next(unsigned INT64 &x)
+{
+	unsigned INT64 z = (x += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
 const char *AbsRndNumGenerator::hex1 = "0123456789ABCDEF";
 
 const char *AbsRndNumGenerator::dec1 = "0123456789";
@@ -90,13 +132,32 @@ AbsRndNumGenerator::make_rndnum_generator(RNDNUM_GENERATOR impl, const unsigned
 void
 AbsRndNumGenerator::seedrand(const unsigned long seed )
 {
-#ifdef HAVE_SRAND48_DETERMINISTIC
-	// OpenBSD requires a special call to activate the standard,
-	// deterministic behavior of `lrand48'.
-	srand48_deterministic(seed);
-#else
-	srand48(seed);
-#endif
+	// the same state srand48(seed) sets up
+	rand48_state[0] = 0x330E;
+	rand48_state[1] = (unsigned short) seed;
+	rand48_state[2] = (unsigned short) (seed >> 16);
+
+	use_xoshiro = (CGOptions::rng_engine() == "xoshiro256");
+	current_stream = rsDefault;
+	for (int i = 0; i < MAX_RANDOM_STREAM; i++) {
+		// every stream starts from the seed and its own number
+		unsigned INT64 x = ((unsigned INT64)seed << 8) | i;
+		for (int j = 0; j < 4; j++) {
+			xoshiro_state[i][j] = splitmix_next(x);
+		}
+	}
+}
+
+/*
+ * Make the following numbers come from the given stream, return the
+ * stream used so far.
+ */
+RandomStream
+AbsRndNumGenerator::select_stream(RandomStream stream)
+{
+	RandomStream old = current_stream;
+	current_stream = stream;
+	return old;
 }
 
 /*
@@ -128,7 +189,11 @@ AbsRndNumGenerator::rnd_shuffle(unsigned int n)
 unsigned long
 AbsRndNumGenerator::genrand(void)
 {
-	return lrand48();
+	if (use_xoshiro) {
+		// 31 bits, like nrand48
+		return (unsigned long)(xoshiro_next(xoshiro_state[current_stream]) >> 33);
+	}
+	return nrand48(rand48_state);
 }
 
 std::string
@@ -42,6 +42,19 @@ enum RNDNUM_GENERATOR {
 
 #define MAX_RNDNUM_GENERATOR (rDFSRndNumGenerator+1)
 
+// Independent streams of random numbers for the parts of the generator, so
+// that changing how many numbers one part draws doesn't shift the numbers
+// the other parts get. Only the xoshiro256 engine has more than one stream.
+enum RandomStream {
+	rsDefault = 0,
+	rsTypes,
+	rsFunctions,
+	rsStatements,
+	rsConstants,
+};
+
+#define MAX_RANDOM_STREAM (rsConstants+1)
+
 // I could make AbsRndNumGenerator not pure, but want to force each subclass implement
 // it's own member functions, in case of forgetting something.
 class AbsRndNumGenerator
@@ -51,6 +64,8 @@ public:
 
 	static void seedrand(const unsigned long seed);
 
+	static RandomStream select_stream(RandomStream stream);
+
 	static const char* get_hex1();
 
 	static const char* get_dec1();
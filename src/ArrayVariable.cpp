@@ -53,6 +53,7 @@
 #include "FactUnion.h"
 #include "Function.h"
 #include "FunctionInvocation.h"
+#include "OutputMgr.h"
 #include "Type.h"
 #include "VariableSelector.h"
 #include "random.h"
@@ -187,6 +188,27 @@ ArrayVariable::CreateArrayVariable(const CGContext& cg_context, Block* blk, cons
 	return var;
 }
 
+// magic number mixed into the choice of array initial values, see build_init_recursive
+static thread_local unsigned init_seed = 0xABCDEF;
+
+void
+ArrayVariable::doFinalization(void)
+{
+	init_seed = 0xABCDEF;
+}
+
+unsigned
+ArrayVariable::get_init_seed(void)
+{
+	return init_seed;
+}
+
+void
+ArrayVariable::set_init_seed(unsigned seed)
+{
+	init_seed = seed;
+}
+
 /*
  *
  */
@@ -458,14 +480,13 @@ string
 ArrayVariable::build_init_recursive(size_t dimen, const vector<string>& init_strings) const
 {
 	assert (dimen < get_dimension());
-	static unsigned seed = 0xABCDEF;
 	string ret = "{";
 	for (size_t i=0; i<sizes[dimen]; i++) {
 		if (dimen == sizes.size() - 1) {
 			// use magic number to choose an initial value
-			size_t rnd_index = ((seed * seed + (i+7) * (i+13)) * 52369) % (init_strings.size());
+			size_t rnd_index = ((init_seed * init_seed + (i+7) * (i+13)) * 52369) % (init_strings.size());
 			ret += init_strings[rnd_index];
-			seed++;
+			init_seed++;
 		 } else {
 			ret += build_init_recursive(dimen + 1, init_strings);
 		 }
@@ -480,7 +501,8 @@ string
 ArrayVariable::build_initializer_str(const vector<string>& init_strings) const
 {
 	string str, str_dimen;
-	if (CGOptions::force_non_uniform_array_init()) {
+	// the non-uniform initializers depend on what was printed before
+	if (CGOptions::force_non_uniform_array_init() && !OutputMgr::canonical_output()) {
 		return build_init_recursive(0, init_strings);
 	}
 
@@ -726,7 +748,7 @@ ArrayVariable::output_addr_checks(std::ostream &out, const Variable* var, string
 	out << " == &";
 	output_with_indices(out, ctrl_vars);
 	out << field_name;
-	out << ")" << endl;
+	out << ")" << '\n';
 	output_open_encloser("{", out, indent);
 	output_tab(out, indent);
 	out << "printf(\"   ";
@@ -741,7 +763,7 @@ ArrayVariable::output_addr_checks(std::ostream &out, const Variable* var, string
 		out << ", ";
 		out << ctrl_vars[i]->get_actual_name();
 	}
-	out << ");" << endl;
+	out << ");" << '\n';
 	output_tab(out, indent);
 	out << "break;";
 	output_close_encloser("}", out, indent);
@@ -770,6 +792,61 @@ ArrayVariable::make_print_index_str(const vector<const Variable *> &cvs) const
 	return str;
 }
 
+/* -------------------------------------------------------------
+ *  the integer type the elements of type <t> are a plain sequence of,
+ *  with <count> of them per element, or NULL if there are other fields,
+ *  bitfields or padding in between
+ ***************************************************************/
+static const Type *
+block_hash_type(const Type *t, size_t &count)
+{
+	if (t->eType == eSimple) {
+		if (t->simple_type == eFloat || t->simple_type == eInt128 || t->simple_type == eUInt128)
+			return NULL;
+		count = 1;
+		return t;
+	}
+	if (t->eType != eStruct || t->has_padding() || t->is_volatile_struct_union())
+		return NULL;
+	const Type *elem = NULL;
+	count = 0;
+	for (size_t i = 0; i < t->fields.size(); i++) {
+		size_t n = 0;
+		const Type *ft = block_hash_type(t->fields[i], n);
+		if (ft == NULL || (elem && ft != elem))
+			return NULL;
+		elem = ft;
+		count += n;
+	}
+	return elem;
+}
+
+/* -------------------------------------------------------------
+ *  with --block-hash, hash an array of integers, or of packed structs
+ *  of one integer type, with a single call to the runtime. The checksum
+ *  is the same as hashing the items one by one.
+ ***************************************************************/
+bool
+ArrayVariable::hash_as_block(std::ostream& out) const
+{
+	// volatile items have to be read one by one
+	if (is_volatile())
+		return false;
+	size_t count = 0;
+	const Type *elem = block_hash_type(type, count);
+	if (elem == NULL || count == 0)
+		return false;
+	for (size_t i = 0; i < sizes.size(); i++)
+		count *= sizes[i];
+	output_tab(out, 1);
+	out << "transparent_crc_block_";
+	elem->Output(out);
+	out << "(&" << get_actual_name() << ", " << count << ", \"" << get_actual_name()
+		<< "\", print_hash_value);";
+	outputln(out);
+	return true;
+}
+
 /* -------------------------------------------------------------
  *  hash all array items
  ***************************************************************/
@@ -795,6 +872,8 @@ ArrayVariable::hash(std::ostream& out) const
 	assert(field_names.size() == field_types.size());
 	// if not a suitable type for hashing, give up
 	if (field_names.size() == 0) return;
+	if (CGOptions::compute_hash() && CGOptions::block_hash() && hash_as_block(out))
+		return;
 
 	size_t i, j;
 	int indent = 1;
@@ -828,17 +907,17 @@ ArrayVariable::hash(std::ostream& out) const
 				output_tab(out, indent);
 				out << "transparent_crc_bytes(&" << vname << field_names[j] << ", ";
 				out << "sizeof(" << vname << field_names[j] << "), ";
-				out << "\"" << vname << field_names[j] << "\", print_hash_value);" << endl;
+				out << "\"" << vname << field_names[j] << "\", print_hash_value);" << '\n';
 			} else {
 				output_tab(out, indent);
 				out << "transparent_crc(" << vname << field_names[j] << ", \"";
-				out << vname << field_names[j] << "\", print_hash_value);" << endl;
+				out << vname << field_names[j] << "\", print_hash_value);" << '\n';
 			}
 		}
 		// print the index value
 		if (CGOptions::hash_value_printf()) {
 			output_tab(out, indent);
-			out << "if (print_hash_value) " << make_print_index_str(cvs) << endl;
+			out << "if (print_hash_value) " << make_print_index_str(cvs) << '\n';
 		}
 	}
 	else {
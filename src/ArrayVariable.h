@@ -44,6 +44,10 @@ class ArrayVariable : public Variable
 {
 public:
 	static ArrayVariable* CreateArrayVariable(const CGContext& cg_context, Block* blk, const std::string &name, const Type *type, const Expression* init, const CVQualifiers* qfer, const Variable* isFieldVarOf);
+	static void doFinalization(void);
+	// the non-uniform initializers printed so far, for printing twice
+	static unsigned get_init_seed(void);
+	static void set_init_seed(unsigned seed);
 	ArrayVariable(const ArrayVariable& av);
 	virtual ~ArrayVariable(void);
 
@@ -89,6 +93,7 @@ public:
 private:
 	ArrayVariable(Block* blk, const std::string &name, const Type *type, const Expression* init, const CVQualifiers* qfer, const vector<unsigned int>& sizes, const Variable* isFieldVarOf);
 
+	bool hash_as_block(std::ostream& out) const;
 
 	const std::vector<unsigned int> sizes;
 	std::vector<const Expression*> indices;
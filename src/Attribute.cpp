@@ -10,6 +10,15 @@
 #include "OutputMgr.h"
 #include "Attribute.h"
 
+void
+AttributeGenerator::clear(void)
+{
+	vector<Attribute*>::iterator itr;
+	for (itr = attributes.begin(); itr != attributes.end(); ++itr)
+		delete *itr;
+	attributes.clear();
+}
+
 void
 AttributeGenerator::Output(std::ostream &out)
 {
@@ -17,6 +17,7 @@ public:
 	//Attribute generation probability
 	int prob;
 	Attribute(string, int);
+	virtual ~Attribute() {}
 	//Checks attribute probability and generate is accordingly
 	virtual string make_random() = 0;
 };
@@ -64,6 +65,7 @@ public:
 	//stores instances of Attribute
 	vector<Attribute*> attributes;
 	void Output(std::ostream &);
+	void clear(void);
 };
 
 #endif
@@ -0,0 +1,98 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef BIT_SET_H
+#define BIT_SET_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <vector>
+
+/*
+ * A set of small non-negative integers (typically Variable ids), one bit per
+ * member. The set grows to hold the largest member added, so a set of early
+ * variables stays small no matter how many variables are created later.
+ */
+class BitSet
+{
+public:
+	BitSet(void) {}
+
+	bool test(size_t i) const;
+	void set(size_t i);
+	void reset(size_t i);
+	void clear(void) { words_.clear(); }
+
+	/* whether the two sets have any member in common */
+	bool intersects(const BitSet& other) const;
+
+private:
+	typedef unsigned long word_t;
+	static const size_t WORD_BITS = sizeof(word_t) * 8;
+
+	std::vector<word_t> words_;
+};
+
+inline bool
+BitSet::test(size_t i) const
+{
+	size_t w = i / WORD_BITS;
+	return w < words_.size() && ((words_[w] >> (i % WORD_BITS)) & 1);
+}
+
+inline void
+BitSet::set(size_t i)
+{
+	size_t w = i / WORD_BITS;
+	if (w >= words_.size()) {
+		words_.resize(w + 1, 0);
+	}
+	words_[w] |= (word_t)1 << (i % WORD_BITS);
+}
+
+inline void
+BitSet::reset(size_t i)
+{
+	size_t w = i / WORD_BITS;
+	if (w < words_.size()) {
+		words_[w] &= ~((word_t)1 << (i % WORD_BITS));
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // BIT_SET_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -64,9 +64,14 @@
 #include "CFGEdge.h"
 #include "Expression.h"
 #include "VectorFilter.h"
+#include "Profiler.h"
+#include "Budget.h"
+#include "TargetSize.h"
 
 using namespace std;
 
+const int Block::MAX_FIXED_POINT_ROUNDS = 8;
+
 ///////////////////////////////////////////////////////////////////////////////
 Block* find_block_by_id(int blk_id)
 {
@@ -155,7 +160,7 @@ Block::make_random(CGContext &cg_context, bool looping)
 	unsigned int i;
 	if (b->stm_id == 1)
 		BREAK_NOP;			// for debugging
-	for (i = 0; i <= max; ++i) {
+	for (i = 0; i <= max || TargetSize::keep_going(b); ++i) {
 		Statement *s = Statement::make_random(cg_context);
 		// In the exhaustive mode, Statement::make_random could return NULL;
 		if (!s)
@@ -264,7 +269,7 @@ Block::OutputTmpVariableList(std::ostream &out, int indent) const
 		enum eSimpleType type = (*i).second;
 		output_tab(out, indent);
 		Type::get_simple_type(type).Output(out);
-		out << " " << name << " = 0;" << std::endl;
+		out << " " << name << " = 0;" << '\n';
 	}
 }
 
@@ -296,7 +301,7 @@ Block::Output(std::ostream &out, FactMgr* fm, int indent) const
 	output_comment_line(out, ss.str());
 
 	if (CGOptions::depth_protect()) {
-		out << "DEPTH++;" << endl;
+		out << "DEPTH++;" << '\n';
 	}
 
 	indent++;
@@ -307,7 +312,7 @@ Block::Output(std::ostream &out, FactMgr* fm, int indent) const
 	OutputStatementList(stms, out, fm, indent);
 
 	if (CGOptions::depth_protect()) {
-		out << "DEPTH--;" << endl;
+		out << "DEPTH--;" << '\n';
 	}
 	indent--;
 
@@ -438,11 +443,11 @@ Block::append_return_stmt(CGContext& cg_context)
 
 	fm->set_fact_in(sr, pre_facts);
 	fm->set_fact_out(sr, fm->global_facts);
-	fm->map_accum_effect[sr] = *(cg_context.get_effect_accum());
+	fm->map_accum_effect.set(sr, *(cg_context.get_effect_accum()));
 	fm->map_visited[sr] = true;
 	//sr->post_creation_analysis(pre_facts, cg_context);
-	fm->map_accum_effect[this] = *(cg_context.get_effect_accum());
-	fm->map_stm_effect[this].add_effect(fm->map_stm_effect[sr]);
+	fm->map_accum_effect.set(this, *(cg_context.get_effect_accum()));
+	fm->map_stm_effect[this].add_effect(fm->map_stm_effect.get(sr));
 	return sr;
 }
 
@@ -488,11 +493,11 @@ Block::append_nested_loop(CGContext& cg_context)
 
 	fm->set_fact_in(sf, pre_facts);
 	fm->set_fact_out(sf, fm->global_facts);
-	fm->map_accum_effect[sf] = *(cg_context.get_effect_accum());
+	fm->map_accum_effect.set(sf, *(cg_context.get_effect_accum()));
 	fm->map_visited[sf] = true;
 	//sf->post_creation_analysis(pre_facts, cg_context);
-	fm->map_accum_effect[this] = *(cg_context.get_effect_accum());
-	fm->map_stm_effect[this].add_effect(fm->map_stm_effect[sf]);
+	fm->map_accum_effect.set(this, *(cg_context.get_effect_accum()));
+	fm->map_stm_effect[this].add_effect(fm->map_stm_effect.get(sf));
 	return sf;
 }
 
@@ -537,7 +542,7 @@ Block::visit_facts(vector<const Fact*>& inputs, CGContext& cg_context) const
 		cg_context.reset_effect_accum(pre_effect);
 		return log_analysis_fail("Block. reason can't converge to fixed point");
 	}
-	inputs = fm->map_facts_out[this];
+	inputs = fm->map_facts_out.get(this);
 	fm->map_visited[this] = true;
 	return true;
 }
@@ -579,29 +584,37 @@ Block::contains_back_edge(void) const
 bool
 Block::find_fixed_point(vector<const Fact*> inputs, vector<const Fact*>& post_facts, CGContext& cg_context, int& fail_index, bool visit_once) const
 {
+	ProfileScope scope(Profiler::pFixedPoint);
 	FactMgr* fm = get_fact_mgr(&cg_context);
-	// include outputs from all back edges leading to this block
 	size_t i;
-	static int g = 0;
+	static thread_local int g = 0;
+	// the back edges leading to this block can not change while we iterate, find them once
 	vector<const CFGEdge*> edges;
-	int cnt = 0;
+	find_edges_in(edges, false, true);
+	int rounds = 0;
+	// rounds entered with the block visited, the first pass of an unvisited block is not one
+	int revisits = 0;
 	do {
 		// if we have never visited the block, force the visitor to go through all statements at least once
 		if (fm->map_visited[this]) {
-			if (cnt++ > 7) {
+			if (revisits++ >= MAX_FIXED_POINT_ROUNDS) {
 				// takes too many iterations to reach a fixed point, must be something wrong
 				assert(0);
 			}
-			find_edges_in(edges, false, true);
+			// include outputs from all back edges leading to this block
 			for (i=0; i<edges.size(); i++) {
 				const Statement* src = edges[i]->src;
 				//assert(fm->map_visited[src]);
-				merge_facts(inputs, fm->map_facts_out[src]);
+				merge_facts(inputs, fm->map_facts_out.get(src));
 			}
 		}
 		if (!visit_once) {
+			// the block input is unchanged since the last round: a fixed point
 			int shortcut = shortcut_analysis(inputs, cg_context);
-			if (shortcut == 0) return true;
+			if (shortcut == 0) {
+				fm->count_fixed_point(rounds);
+				return true;
+			}
 		}
 		//if (shortcut == 1) return false;
 
@@ -612,13 +625,18 @@ Block::find_fixed_point(vector<const Fact*> inputs, vector<const Fact*>& post_fa
 			FactMgr::add_new_var_fact(v, outputs);
 		}
 
-		// revisit statements with new inputs
+		// revisit statements with new inputs. statements whose inputs did not change
+		// are bypassed by Statement::shortcut_analysis, we visit them in order anyway
+		// because effects are accumulated in program order
+		rounds++;
+		Budget::count_fact_iteration();
 		for (i=0; i<stms.size(); i++) {
 			int h = g++;
 			if (h == 558)
 				BREAK_NOP;		// for debugging
 			if (!stms[i]->analyze_with_edges_in(outputs, cg_context)) {
 				fail_index = i;
+				fm->count_fixed_point(rounds);
 				return false;
 			}
 		}
@@ -641,10 +659,10 @@ Block::set_accumulated_effect(CGContext& cg_context) const
 	FactMgr* fm = get_fact_mgr(&cg_context);
 	for (size_t i=0; i<stms.size(); i++) {
 		Statement* s = stms[i];
-		eff.add_effect(fm->map_stm_effect[s]);
+		eff.add_effect(fm->map_stm_effect.get(s));
 	}
 	//cg_context.get_effect_stm() = eff;
-	fm->map_stm_effect[this] = eff;
+	fm->map_stm_effect.set(this, eff);
 }
 
 /*
@@ -771,7 +789,7 @@ Block::post_creation_analysis(CGContext& cg_context, const Effect& pre_effect)
 			self_back_edge = true;
 			fm->create_cfg_edge(this, this, false, true);
 		}
-		vector<const Fact*> facts_copy = fm->map_facts_in[this];
+		vector<const Fact*> facts_copy = fm->map_facts_in.get(this);
 		// reset the accumulative effect
 		cg_context.reset_effect_accum(pre_effect);
 		while (!find_fixed_point(facts_copy, post_facts, cg_context, index, need_revisit)) {
@@ -794,14 +812,14 @@ Block::post_creation_analysis(CGContext& cg_context, const Effect& pre_effect)
 			// reset incoming effects
 			cg_context.reset_effect_accum(pre_effect);
 		}
-		fm->global_facts = fm->map_facts_out[this];
+		fm->global_facts = fm->map_facts_out.get(this);
 	}
 	// make sure we add back return statement for blocks that require it and had such statement deleted
 	// only do this for top-level block of a function which requires a return statement
 	if (parent == 0 && func->need_return_stmt() && !must_return()) {
 		fm->global_facts = post_facts;
 		Statement* sr = append_return_stmt(cg_context);
-		fm->set_fact_out(this, fm->map_facts_out[sr]);
+		fm->set_fact_out(this, fm->map_facts_out.get(sr));
 	}
 }
 
@@ -120,6 +120,9 @@ public:
 
 	std::vector<const Statement*> break_stms;
 
+	// rounds we allow find_fixed_point to take before giving up
+	static const int MAX_FIXED_POINT_ROUNDS;
+
 private:
 
 	bool depth_protect;
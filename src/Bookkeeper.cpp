@@ -56,44 +56,44 @@ using namespace std;
 ///////////////////////////////////////////////////////////////////////////////
 
 // counter for all levels of struct depth
-std::vector<int> Bookkeeper::struct_depth_cnts;
-int Bookkeeper::union_var_cnt = 0;
-std::vector<int> Bookkeeper::expr_depth_cnts;
-std::vector<int> Bookkeeper::blk_depth_cnts;
-std::vector<int> Bookkeeper::dereference_level_cnts;
-int Bookkeeper::address_taken_cnt = 0;
-std::vector<int> Bookkeeper::read_dereference_cnts;
-std::vector<int> Bookkeeper::write_dereference_cnts;
-int Bookkeeper::cmp_ptr_to_null = 0;
-int Bookkeeper::cmp_ptr_to_ptr = 0;
-int Bookkeeper::cmp_ptr_to_addr = 0;
-int Bookkeeper::read_volatile_cnt = 0;
-int Bookkeeper::write_volatile_cnt = 0;
-int Bookkeeper::read_non_volatile_cnt = 0;
-int Bookkeeper::write_non_volatile_cnt = 0;
-int Bookkeeper::read_volatile_thru_ptr_cnt = 0;
-int Bookkeeper::write_volatile_thru_ptr_cnt = 0;
-int Bookkeeper::pointer_avail_for_dereference = 0;
-int Bookkeeper::volatile_avail = 0;
-int Bookkeeper::structs_with_bitfields = 0;
-std::vector<int> Bookkeeper::vars_with_bitfields;
-std::vector<int> Bookkeeper::vars_with_full_bitfields;
-int Bookkeeper::vars_with_bitfields_address_taken_cnt = 0;
-int Bookkeeper::bitfields_in_total = 0;
-int Bookkeeper::unamed_bitfields_in_total = 0;
-int Bookkeeper::const_bitfields_in_total = 0;
-int Bookkeeper::volatile_bitfields_in_total = 0;
-int Bookkeeper::lhs_bitfields_structs_vars_cnt = 0;
-int Bookkeeper::rhs_bitfields_structs_vars_cnt = 0;
-int Bookkeeper::lhs_bitfield_cnt = 0;
-int Bookkeeper::rhs_bitfield_cnt = 0;
-int Bookkeeper::forward_jump_cnt = 0;
-int Bookkeeper::backward_jump_cnt = 0;
-int Bookkeeper::use_new_var_cnt = 0;
-int Bookkeeper::use_old_var_cnt = 0;
-int Bookkeeper::oob_cnt = 0;
-bool Bookkeeper::rely_on_int_size = false;
-bool Bookkeeper::rely_on_ptr_size = false;
+thread_local std::vector<int> Bookkeeper::struct_depth_cnts;
+thread_local int Bookkeeper::union_var_cnt = 0;
+thread_local std::vector<int> Bookkeeper::expr_depth_cnts;
+thread_local std::vector<int> Bookkeeper::blk_depth_cnts;
+thread_local std::vector<int> Bookkeeper::dereference_level_cnts;
+thread_local int Bookkeeper::address_taken_cnt = 0;
+thread_local std::vector<int> Bookkeeper::read_dereference_cnts;
+thread_local std::vector<int> Bookkeeper::write_dereference_cnts;
+thread_local int Bookkeeper::cmp_ptr_to_null = 0;
+thread_local int Bookkeeper::cmp_ptr_to_ptr = 0;
+thread_local int Bookkeeper::cmp_ptr_to_addr = 0;
+thread_local int Bookkeeper::read_volatile_cnt = 0;
+thread_local int Bookkeeper::write_volatile_cnt = 0;
+thread_local int Bookkeeper::read_non_volatile_cnt = 0;
+thread_local int Bookkeeper::write_non_volatile_cnt = 0;
+thread_local int Bookkeeper::read_volatile_thru_ptr_cnt = 0;
+thread_local int Bookkeeper::write_volatile_thru_ptr_cnt = 0;
+thread_local int Bookkeeper::pointer_avail_for_dereference = 0;
+thread_local int Bookkeeper::volatile_avail = 0;
+thread_local int Bookkeeper::structs_with_bitfields = 0;
+thread_local std::vector<int> Bookkeeper::vars_with_bitfields;
+thread_local std::vector<int> Bookkeeper::vars_with_full_bitfields;
+thread_local int Bookkeeper::vars_with_bitfields_address_taken_cnt = 0;
+thread_local int Bookkeeper::bitfields_in_total = 0;
+thread_local int Bookkeeper::unamed_bitfields_in_total = 0;
+thread_local int Bookkeeper::const_bitfields_in_total = 0;
+thread_local int Bookkeeper::volatile_bitfields_in_total = 0;
+thread_local int Bookkeeper::lhs_bitfields_structs_vars_cnt = 0;
+thread_local int Bookkeeper::rhs_bitfields_structs_vars_cnt = 0;
+thread_local int Bookkeeper::lhs_bitfield_cnt = 0;
+thread_local int Bookkeeper::rhs_bitfield_cnt = 0;
+thread_local int Bookkeeper::forward_jump_cnt = 0;
+thread_local int Bookkeeper::backward_jump_cnt = 0;
+thread_local int Bookkeeper::use_new_var_cnt = 0;
+thread_local int Bookkeeper::use_old_var_cnt = 0;
+thread_local int Bookkeeper::oob_cnt = 0;
+thread_local bool Bookkeeper::rely_on_int_size = false;
+thread_local bool Bookkeeper::rely_on_ptr_size = false;
 
 /*
  *
@@ -113,13 +113,13 @@ Bookkeeper::~Bookkeeper(void)
 static void
 formated_output(std::ostream &out, const char* msg, int num)
 {
-	out << "XXX " << msg << num << endl;
+	out << "XXX " << msg << num << '\n';
 }
 
 static void
 formated_outputf(std::ostream &out, const char* msg, double num)
 {
-	out << "XXX " << msg << num << endl;
+	out << "XXX " << msg << num << '\n';
 }
 
 void
@@ -134,7 +134,35 @@ Bookkeeper::doFinalization()
 	Bookkeeper::cmp_ptr_to_null = 0;
 	Bookkeeper::cmp_ptr_to_ptr = 0;
 	Bookkeeper::cmp_ptr_to_addr = 0;
-
+	Bookkeeper::union_var_cnt = 0;
+	Bookkeeper::blk_depth_cnts.clear();
+	Bookkeeper::read_volatile_cnt = 0;
+	Bookkeeper::write_volatile_cnt = 0;
+	Bookkeeper::read_non_volatile_cnt = 0;
+	Bookkeeper::write_non_volatile_cnt = 0;
+	Bookkeeper::read_volatile_thru_ptr_cnt = 0;
+	Bookkeeper::write_volatile_thru_ptr_cnt = 0;
+	Bookkeeper::pointer_avail_for_dereference = 0;
+	Bookkeeper::volatile_avail = 0;
+	Bookkeeper::structs_with_bitfields = 0;
+	Bookkeeper::vars_with_bitfields.clear();
+	Bookkeeper::vars_with_full_bitfields.clear();
+	Bookkeeper::vars_with_bitfields_address_taken_cnt = 0;
+	Bookkeeper::bitfields_in_total = 0;
+	Bookkeeper::unamed_bitfields_in_total = 0;
+	Bookkeeper::const_bitfields_in_total = 0;
+	Bookkeeper::volatile_bitfields_in_total = 0;
+	Bookkeeper::lhs_bitfields_structs_vars_cnt = 0;
+	Bookkeeper::rhs_bitfields_structs_vars_cnt = 0;
+	Bookkeeper::lhs_bitfield_cnt = 0;
+	Bookkeeper::rhs_bitfield_cnt = 0;
+	Bookkeeper::forward_jump_cnt = 0;
+	Bookkeeper::backward_jump_cnt = 0;
+	Bookkeeper::use_new_var_cnt = 0;
+	Bookkeeper::use_old_var_cnt = 0;
+	Bookkeeper::oob_cnt = 0;
+	Bookkeeper::rely_on_int_size = false;
+	Bookkeeper::rely_on_ptr_size = false;
 }
 
 int
@@ -176,10 +204,10 @@ Bookkeeper::output_stmts_statistics(std::ostream &out)
 	int stmt_cnt = stat_blk_depths();
 	formated_output(out, "stmts: ", stmt_cnt);
 	formated_output(out, "max block depth: ", (blk_depth_cnts.size() - 1));
-	out << "breakdown:" << endl;
+	out << "breakdown:" << '\n';
 	for (i=0; i<blk_depth_cnts.size(); i++) {
 		if (blk_depth_cnts[i]) {
-			out << "   depth: " << i << ", occurrence: " << blk_depth_cnts[i] << endl;
+			out << "   depth: " << i << ", occurrence: " << blk_depth_cnts[i] << '\n';
 		}
 	}
 }
@@ -188,36 +216,40 @@ void
 Bookkeeper::output_statistics(std::ostream &out)
 {
 	output_struct_union_statistics(out);
-	out << endl;
+	out << '\n';
 	output_expr_statistics(out);
-	out << endl;
+	out << '\n';
 	output_pointer_statistics(out);
-	out << endl;
+	out << '\n';
 	output_volatile_access_statistics(out);
-	out << endl;
+	out << '\n';
 	output_jump_statistics(out);
-	out << endl;
+	out << '\n';
 	output_stmts_statistics(out);
-	out << endl;
+	out << '\n';
 	output_var_freshness(out);
 	if (rely_on_int_size) {
 		out << "FYI: the random generator makes assumptions about the integer size. See ";
-		out << PLATFORM_CONFIG_FILE << " for more details." << endl;
+		out << PLATFORM_CONFIG_FILE << " for more details." << '\n';
 	}
 	if (rely_on_ptr_size) {
 		out << "FYI: the random generator makes assumptions about the pointer size. See ";
-		out << PLATFORM_CONFIG_FILE << " for more details." << endl;
+		out << PLATFORM_CONFIG_FILE << " for more details." << '\n';
 	}
 	output_oob_statistics(out);
+	if (CGOptions::fixed_point_stats()) {
+		out << '\n';
+		output_fixed_point_statistics(out);
+	}
 }
 
 void
 Bookkeeper::output_struct_union_statistics(std::ostream &out)
 {
 	formated_output(out, "max struct depth: ", (struct_depth_cnts.size()-1));
-	out << "breakdown:" << endl;
+	out << "breakdown:" << '\n';
 	for (size_t i=0; i<struct_depth_cnts.size(); i++) {
-		out << "   depth: " << i << ", occurrence: " << struct_depth_cnts[i] << endl;
+		out << "   depth: " << i << ", occurrence: " << struct_depth_cnts[i] << '\n';
 	}
 	formated_output(out, "total union variables: ", union_var_cnt);
 	Bookkeeper::output_bitfields(out);
@@ -229,6 +261,20 @@ Bookkeeper::output_oob_statistics(std::ostream &out)
     formated_output(out, "total OOB instances added: ", oob_cnt);
 }
 
+void
+Bookkeeper::output_fixed_point_statistics(std::ostream &out)
+{
+	out << "fixed point iterations per function:" << '\n';
+	const vector<Function*>& funcs = get_all_functions();
+	for (size_t i=0; i<funcs.size(); i++) {
+		const FactMgr* fm = funcs[i]->fm;
+		if (funcs[i]->is_builtin || fm == 0)
+			continue;
+		out << "   ";
+		fm->output_fixed_point_statistics(out);
+	}
+}
+
 void
 Bookkeeper::stat_expr_depths_for_stmt(const Statement* s)
 {
@@ -264,10 +310,10 @@ Bookkeeper::output_expr_statistics(std::ostream &out)
 	size_t i;
 	stat_expr_depths();
 	formated_output(out, "max expression depth: ", (expr_depth_cnts.size() - 1));
-	out << "breakdown:" << endl;
+	out << "breakdown:" << '\n';
 	for (i=0; i<expr_depth_cnts.size(); i++) {
 		if (expr_depth_cnts[i]) {
-			out << "   depth: " << i << ", occurrence: " << expr_depth_cnts[i] << endl;
+			out << "   depth: " << i << ", occurrence: " << expr_depth_cnts[i] << '\n';
 		}
 	}
 }
@@ -304,17 +350,17 @@ Bookkeeper::output_pointer_statistics(std::ostream &out)
 
 	formated_output(out, "total number of pointers: ", ptrs.size());
 	if (ptrs.size() > 0) {
-		out << endl;
+		out << '\n';
 		formated_output(out, "times a variable address is taken: ", address_taken_cnt);
 		formated_output(out, "times a pointer is dereferenced on RHS: ", calc_total(read_dereference_cnts));
-		out << "breakdown:" << endl;
+		out << "breakdown:" << '\n';
 		for (i=1; i<read_dereference_cnts.size(); i++) {
-			out << "   depth: " << i << ", occurrence: " << read_dereference_cnts[i] << endl;
+			out << "   depth: " << i << ", occurrence: " << read_dereference_cnts[i] << '\n';
 		}
 		formated_output(out, "times a pointer is dereferenced on LHS: ", calc_total(write_dereference_cnts));
-		out << "breakdown:" << endl;
+		out << "breakdown:" << '\n';
 		for (i=1; i<write_dereference_cnts.size(); i++) {
-			out << "   depth: " << i << ", occurrence: " << write_dereference_cnts[i] << endl;
+			out << "   depth: " << i << ", occurrence: " << write_dereference_cnts[i] << '\n';
 		}
 		formated_output(out, "times a pointer is compared with null: ", cmp_ptr_to_null);
 		formated_output(out, "times a pointer is compared with address of another variable: ", cmp_ptr_to_addr);
@@ -323,11 +369,11 @@ Bookkeeper::output_pointer_statistics(std::ostream &out)
 
 		// if there are dereferenced pointers
 		if (dereference_level_cnts.size()) {
-			out << endl;
+			out << '\n';
 			formated_output(out, "max dereference level: ", dereference_level_cnts.size()-1);
-			out << "breakdown:" << endl;
+			out << "breakdown:" << '\n';
 			for (i=0; i<dereference_level_cnts.size(); i++) {
-				out << "   level: " << i << ", occurrence: " << dereference_level_cnts[i] << endl;
+				out << "   level: " << i << ", occurrence: " << dereference_level_cnts[i] << '\n';
 			}
 		}
 		formated_output(out, "number of pointers point to pointers: ", point_to_pointer);
@@ -466,7 +512,7 @@ void
 Bookkeeper::output_bitfields(std::ostream &out)
 {
 	if (CGOptions::bitfields()) {
-		out << std::endl;
+		out << '\n';
 		//formated_output(out, "structs with full-bitfields: ", structs_with_bitfields);
 		formated_output(out, "non-zero bitfields defined in structs: ", bitfields_in_total);
 		formated_output(out, "zero bitfields defined in structs: ", unamed_bitfields_in_total);
@@ -544,9 +590,9 @@ Bookkeeper::output_counters(std::ostream &out, const char* prefix_msg,
 {
 	assert(prefix_msg && breakdown_msg);
 	formated_output(out, prefix_msg, calc_total(counters));
-	out << "breakdown:" << std::endl;
+	out << "breakdown:" << '\n';
 	for (size_t i=starting_pos; i<counters.size(); i++) {
-		out << "   " << breakdown_msg << ": " << i << ", occurrence: " << counters[i] << endl;
+		out << "   " << breakdown_msg << ": " << i << ", occurrence: " << counters[i] << '\n';
 	}
 }
 
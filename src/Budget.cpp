@@ -0,0 +1,126 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "Budget.h"
+#include <chrono>
+#include <iostream>
+
+#include "CGOptions.h"
+#include "Statement.h"
+
+using namespace std;
+
+static const char *budget_names[Budget::MAX_BUDGET] = {
+	"time",
+	"statement",
+	"fact iteration",
+};
+
+thread_local bool Budget::active = false;
+thread_local Budget::Kind Budget::reached_kind = Budget::MAX_BUDGET;
+thread_local double Budget::deadline = 0;
+thread_local unsigned long Budget::fact_iterations = 0;
+
+static double
+now(void)
+{
+	return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void
+Budget::start(void)
+{
+	active = CGOptions::budget_time() > 0 || CGOptions::budget_stmts() > 0 ||
+		CGOptions::budget_fact_iterations() > 0;
+	reached_kind = MAX_BUDGET;
+	deadline = now() + CGOptions::budget_time();
+	fact_iterations = 0;
+}
+
+bool
+Budget::check(void)
+{
+	if (!active) {
+		return false;
+	}
+	if (reached_kind != MAX_BUDGET) {
+		return true;
+	}
+	if (CGOptions::budget_stmts() > 0 && Statement::get_current_sid() >= CGOptions::budget_stmts()) {
+		hit(bStmts);
+	}
+	else if (CGOptions::budget_fact_iterations() > 0 &&
+			 fact_iterations >= static_cast<unsigned long>(CGOptions::budget_fact_iterations())) {
+		hit(bFactIterations);
+	}
+	else if (CGOptions::budget_time() > 0 && now() >= deadline) {
+		hit(bTime);
+	}
+	return reached_kind != MAX_BUDGET;
+}
+
+void
+Budget::hit(Kind k)
+{
+	reached_kind = k;
+	cerr << "csmith: the " << budget_names[k] << " budget is reached after "
+		 << Statement::get_current_sid() << " statements, finishing the program early" << endl;
+}
+
+/*
+ * Tell the reader of the program that it was cut short
+ */
+void
+Budget::OutputBudget(std::ostream &out)
+{
+	if (reached_kind == MAX_BUDGET) {
+		return;
+	}
+	out << "/* the " << budget_names[reached_kind] << " budget was reached, "
+		<< "the program was finished early */" << '\n';
+	out << '\n';
+}
+
+void
+Budget::doFinalization(void)
+{
+	active = false;
+	reached_kind = MAX_BUDGET;
+	fact_iterations = 0;
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
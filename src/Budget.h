@@ -0,0 +1,89 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#ifndef BUDGET_H
+#define BUDGET_H
+
+#include <ostream>
+
+/*
+ * Limits on the work of generating one program, so that a pathological
+ * seed still gives a program in bounded time instead of being killed from
+ * outside. Once a budget is reached, no new functions or statements are
+ * created (see Function::reach_max_functions_cnt and Statement::make_random)
+ * and the program is finished the way --stop-by-stmt finishes it.
+ *
+ * The budgets are checked once at the start of each statement. Everything
+ * in between sees the same answer, so a filter never changes its mind
+ * between listing the admissible choices and checking the one drawn.
+ */
+class Budget
+{
+public:
+	enum Kind {
+		bTime,
+		bStmts,
+		bFactIterations,
+		MAX_BUDGET
+	};
+
+	static void start(void);
+
+	// check the budgets, true once any of them is reached
+	static bool check(void);
+
+	// the answer of the last check
+	static bool reached(void) { return reached_kind != MAX_BUDGET; }
+
+	static void count_fact_iteration(void) { fact_iterations++; }
+
+	static void OutputBudget(std::ostream &out);
+
+	static void doFinalization(void);
+
+private:
+	static void hit(Kind k);
+
+	static thread_local bool active;
+
+	// the budget reached first, MAX_BUDGET if none
+	static thread_local Kind reached_kind;
+
+	static thread_local double deadline;
+
+	static thread_local unsigned long fact_iterations;
+};
+
+#endif // BUDGET_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -75,13 +75,28 @@ int CGOptions::pointer_size_ = 0;
 #define DEFINE_GETTER_SETTER_STRING_REF(f) \
 	DEFINE_GETTER_SETTER(std::string, "", f)
 
+/*
+ * For the few options that are changed while a program is generated. Each
+ * thread of --jobs gets its own copy, seeded from the parsed value
+ */
+#define DEFINE_THREAD_LOCAL_GETTER_SETTER(type, init, f)	\
+	thread_local type CGOptions::f##_ = (init); \
+	type \
+	CGOptions::f(void) { return f##_; }	\
+	type \
+	CGOptions::f(type p) { f##_ = p; return p; }
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEFINE_GETTER_SETTER_BOOL(compute_hash)
+DEFINE_GETTER_SETTER_BOOL(fast_crc)
+DEFINE_GETTER_SETTER_BOOL(block_hash)
+DEFINE_GETTER_SETTER_BOOL(callee_summaries)
 DEFINE_GETTER_SETTER_BOOL(depth_protect)
 DEFINE_GETTER_SETTER_INT (max_split_files)
 DEFINE_GETTER_SETTER_STRING_REF(split_files_dir)
-DEFINE_GETTER_SETTER_STRING_REF(output_file)
+DEFINE_GETTER_SETTER_BOOL(balance_split_files)
+DEFINE_THREAD_LOCAL_GETTER_SETTER(std::string, "", output_file)
 DEFINE_GETTER_SETTER_INT (max_funcs)
 DEFINE_GETTER_SETTER_INT (max_params)
 DEFINE_GETTER_SETTER_INT (max_block_size)
@@ -106,11 +121,20 @@ DEFINE_GETTER_SETTER_INT (interested_facts)
 DEFINE_GETTER_SETTER_BOOL(paranoid)
 DEFINE_GETTER_SETTER_BOOL(quiet)
 DEFINE_GETTER_SETTER_BOOL(concise)
+DEFINE_GETTER_SETTER_BOOL(fixed_point_stats)
+DEFINE_GETTER_SETTER_BOOL(stream_output)
+DEFINE_GETTER_SETTER_BOOL(profile)
+DEFINE_GETTER_SETTER_BOOL(direct_sampling)
+DEFINE_GETTER_SETTER_STRING_REF(rng_engine)
+DEFINE_GETTER_SETTER_STRING_REF(record_trace)
+DEFINE_GETTER_SETTER_STRING_REF(replay_trace)
 DEFINE_GETTER_SETTER_BOOL(nomain)
 DEFINE_GETTER_SETTER_BOOL(random_based)
 DEFINE_GETTER_SETTER_BOOL(dfs_exhaustive)
 DEFINE_GETTER_SETTER_STRING_REF(dfs_debug_sequence)
 DEFINE_GETTER_SETTER_INT (max_exhaustive_depth)
+DEFINE_GETTER_SETTER_INT (dfs_jobs)
+DEFINE_GETTER_SETTER_BOOL(dfs_prune_duplicates)
 DEFINE_GETTER_SETTER_BOOL(compact_output)
 DEFINE_GETTER_SETTER_INT(func1_max_params)
 DEFINE_GETTER_SETTER_BOOL(klee)
@@ -149,7 +173,7 @@ DEFINE_GETTER_SETTER_BOOL(volatiles)
 DEFINE_GETTER_SETTER_BOOL(volatile_pointers)
 DEFINE_GETTER_SETTER_BOOL(const_pointers)
 DEFINE_GETTER_SETTER_BOOL(global_variables)
-DEFINE_GETTER_SETTER_BOOL(access_once)
+DEFINE_THREAD_LOCAL_GETTER_SETTER(bool, false, access_once)
 DEFINE_GETTER_SETTER_BOOL(strict_volatile_rule)
 DEFINE_GETTER_SETTER_BOOL(addr_taken_of_locals)
 DEFINE_GETTER_SETTER_BOOL(fresh_array_ctrl_var_names)
@@ -161,13 +185,19 @@ DEFINE_GETTER_SETTER_BOOL(muls)
 DEFINE_GETTER_SETTER_BOOL(accept_argc)
 DEFINE_GETTER_SETTER_BOOL(random_random)
 DEFINE_GETTER_SETTER_INT(stop_by_stmt)
+DEFINE_GETTER_SETTER_INT(budget_time)
+DEFINE_GETTER_SETTER_INT(budget_stmts)
+DEFINE_GETTER_SETTER_INT(budget_fact_iterations)
+DEFINE_GETTER_SETTER_INT(target_min)
+DEFINE_GETTER_SETTER_INT(target_max)
+DEFINE_GETTER_SETTER_BOOL(target_stmts)
 DEFINE_GETTER_SETTER_BOOL(step_hash_by_stmt)
 DEFINE_GETTER_SETTER_BOOL(compound_assignment)
 DEFINE_GETTER_SETTER_STRING_REF(dump_default_probabilities)
 DEFINE_GETTER_SETTER_STRING_REF(dump_random_probabilities)
 DEFINE_GETTER_SETTER_STRING_REF(probability_configuration)
 DEFINE_GETTER_SETTER_BOOL(const_as_condition)
-DEFINE_GETTER_SETTER_BOOL(match_exact_qualifiers)
+DEFINE_THREAD_LOCAL_GETTER_SETTER(bool, false, match_exact_qualifiers)
 DEFINE_GETTER_SETTER_BOOL(blind_check_global)
 DEFINE_GETTER_SETTER_BOOL(no_return_dead_ptr)
 DEFINE_GETTER_SETTER_BOOL(hash_value_printf)
@@ -217,6 +247,9 @@ CGOptions::set_default_settings(void)
 {
 	set_platform_specific_options();
 	compute_hash(true);
+	fast_crc(false);
+	block_hash(false);
+	callee_summaries(false);
 	max_funcs(CGOPTIONS_DEFAULT_MAX_SPLIT_FILES);
 	max_funcs(CGOPTIONS_DEFAULT_MAX_FUNCS);
 	max_params(CGOPTIONS_DEFAULT_MAX_PARAMS);
@@ -232,6 +265,8 @@ CGOptions::set_default_settings(void)
 	max_array_length_per_dimension(CGOPTIONS_DEFAULT_MAX_ARRAY_LENGTH_PER_DIMENSION);
 	max_array_length(CGOPTIONS_DEFAULT_MAX_ARRAY_LENGTH);
 	max_exhaustive_depth(CGOPTIONS_DEFAULT_MAX_EXHAUSTIVE_DEPTH);
+	dfs_jobs(1);
+	dfs_prune_duplicates(false);
 	max_indirect_level(CGOPTIONS_DEFAULT_MAX_INDIRECT_LEVEL);
 	output_file(CGOPTIONS_DEFAULT_OUTPUT_FILE);
 	interested_facts(ePointTo | eUnionWrite);
@@ -240,6 +275,14 @@ CGOptions::set_default_settings(void)
 	CGOptions::paranoid(false);
 	CGOptions::quiet(false);
 	CGOptions::concise(false);
+	CGOptions::fixed_point_stats(false);
+	CGOptions::stream_output(false);
+	CGOptions::balance_split_files(false);
+	CGOptions::profile(false);
+	CGOptions::direct_sampling(false);
+	CGOptions::rng_engine("lrand48");
+	CGOptions::record_trace("");
+	CGOptions::replay_trace("");
 	CGOptions::nomain(false);
 	random_based(true);
 	use_struct(true);
@@ -283,6 +326,12 @@ CGOptions::set_default_settings(void)
 	muls(true);
 	accept_argc(true);
 	stop_by_stmt(-1);
+	budget_time(0);
+	budget_stmts(0);
+	budget_fact_iterations(0);
+	target_min(0);
+	target_max(0);
+	target_stmts(false);
 	step_hash_by_stmt(false);
 	const_as_condition(false);
 	match_exact_qualifiers(false);
@@ -446,6 +495,26 @@ bool CGOptions::resolve_exhaustive_options()
 		conflict_msg_ = "max-exhaustive-depth must be at least 0";
 		return true;
 	}
+	// the counted names depend on how many programs were enumerated before
+	if (CGOptions::dfs_jobs() > 1 && CGOptions::prefix_name() &&
+		!CGOptions::sequence_name_prefix()) {
+		conflict_msg_ = "--jobs with --dfs-exhaustive needs --sequence-name-prefix when names are prefixed";
+		return true;
+	}
+	if (CGOptions::dfs_prune_duplicates()) {
+		// which duplicate is kept depends on the order of the search
+		if (CGOptions::dfs_jobs() > 1) {
+			conflict_msg_ = "--dfs-prune-duplicates does not work with --jobs";
+			return true;
+		}
+		// the programs are printed to be compared, and attributes draw
+		// random numbers when printed
+		if (CGOptions::func_attr_flag() || CGOptions::type_attr_flag() ||
+		    CGOptions::label_attr_flag() || CGOptions::var_attr_flag()) {
+			conflict_msg_ = "--dfs-prune-duplicates does not work with the attribute options";
+			return true;
+		}
+	}
 
 	if (!CGOptions::use_struct() && CGOptions::expand_struct()) {
 		conflict_msg_ = "expand-struct cannot be used with --no-struct";
@@ -556,6 +625,14 @@ CGOptions::has_conflict(void)
 	if (CGOptions::split_files_dir().empty()) {
 		CGOptions::split_files_dir(CGOPTIONS_DEFAULT_SPLIT_FILES_DIR);
 	}
+	if (CGOptions::balance_split_files() && CGOptions::max_split_files() == 0) {
+		conflict_msg_ = "--balance-split-files needs --max-split-files";
+		return true;
+	}
+	if (CGOptions::balance_split_files()) {
+		// the files are compiled separately and linked together
+		CGOptions::force_globals_static(false);
+	}
 	if (CGOptions::max_split_files() > 0) {
 		if (!DefaultOutputMgr::create_output_dir(CGOptions::split_files_dir())) {
 			conflict_msg_ = "cannot create dir for split files!";
@@ -568,6 +645,66 @@ CGOptions::has_conflict(void)
 		return true;
 	}
 
+	if (CGOptions::rng_engine() != "lrand48" && CGOptions::rng_engine() != "xoshiro256") {
+		conflict_msg_ = "--rng must be lrand48 or xoshiro256";
+		return true;
+	}
+
+	if (!CGOptions::record_trace().empty() || !CGOptions::replay_trace().empty()) {
+		if (!CGOptions::record_trace().empty() && !CGOptions::replay_trace().empty()) {
+			conflict_msg_ = "--record-trace and --replay-trace cannot be used together";
+			return true;
+		}
+		if (CGOptions::dfs_exhaustive()) {
+			conflict_msg_ = "--record-trace and --replay-trace cannot be used together with --dfs-exhaustive";
+			return true;
+		}
+	}
+
+	if (CGOptions::direct_sampling() && CGOptions::dfs_exhaustive()) {
+		conflict_msg_ = "--direct-sampling only applies to random generation, not to --dfs-exhaustive";
+		return true;
+	}
+
+	if (CGOptions::stream_output()) {
+		// functions are written before the facts and the address-taken flags
+		// of variables are final, and attributes would draw random numbers
+		// in the middle of the generation
+		if (CGOptions::paranoid() || CGOptions::access_once()) {
+			conflict_msg_ = "--stream-output does not work with --paranoid or --access-once";
+			return true;
+		}
+		if (CGOptions::max_split_files() > 0 || CGOptions::dfs_exhaustive()) {
+			conflict_msg_ = "--stream-output does not work with --max-split-files or --dfs-exhaustive";
+			return true;
+		}
+		if (CGOptions::func_attr_flag() || CGOptions::type_attr_flag() ||
+		    CGOptions::label_attr_flag() || CGOptions::var_attr_flag()) {
+			conflict_msg_ = "--stream-output does not work with the attribute options";
+			return true;
+		}
+	}
+
+	if (CGOptions::target_min() > 0 || CGOptions::target_max() > 0) {
+		// functions are measured by rendering them in the middle of the
+		// generation, where attributes would draw random numbers
+		if (CGOptions::func_attr_flag() || CGOptions::type_attr_flag() ||
+		    CGOptions::label_attr_flag() || CGOptions::var_attr_flag()) {
+			conflict_msg_ = "--target-size does not work with the attribute options";
+			return true;
+		}
+		if (CGOptions::dfs_exhaustive()) {
+			conflict_msg_ = "--target-size only applies to random generation, not to --dfs-exhaustive";
+			return true;
+		}
+	}
+
+	if ((CGOptions::budget_time() > 0 || CGOptions::budget_stmts() > 0 ||
+		 CGOptions::budget_fact_iterations() > 0) && CGOptions::dfs_exhaustive()) {
+		conflict_msg_ = "the --budget-* options only apply to random generation, not to --dfs-exhaustive";
+		return true;
+	}
+
 #if 0
 	Probabilities *prob = Probabilities::GetInstance();
 	if (!(CGOptions::dump_default_probabilities().empty()))
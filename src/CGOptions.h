@@ -72,6 +72,15 @@ public:
 	static bool compute_hash(void);
 	static bool compute_hash(bool p);
 
+	static bool fast_crc(void);
+	static bool fast_crc(bool p);
+
+	static bool block_hash(void);
+	static bool block_hash(bool p);
+
+	static bool callee_summaries(void);
+	static bool callee_summaries(bool p);
+
 	static bool depth_protect(void);
 	static bool depth_protect(bool p);
 
@@ -81,6 +90,9 @@ public:
 	static std::string split_files_dir(void);
 	static std::string split_files_dir(std::string p);
 
+	static bool balance_split_files(void);
+	static bool balance_split_files(bool p);
+
 	static std::string output_file(void);
 	static std::string output_file(std::string p);
 
@@ -159,6 +171,27 @@ public:
 	static bool concise(void);
 	static bool concise(bool p);
 
+	static bool fixed_point_stats(void);
+	static bool fixed_point_stats(bool p);
+
+	static bool stream_output(void);
+	static bool stream_output(bool p);
+
+	static bool profile(void);
+	static bool profile(bool p);
+
+	static bool direct_sampling(void);
+	static bool direct_sampling(bool p);
+
+	static std::string rng_engine(void);
+	static std::string rng_engine(std::string p);
+
+	static std::string record_trace(void);
+	static std::string record_trace(std::string p);
+
+	static std::string replay_trace(void);
+	static std::string replay_trace(std::string p);
+
 	static bool nomain(void);
 	static bool nomain(bool p);
 
@@ -174,6 +207,12 @@ public:
 	static int max_exhaustive_depth(void);
 	static int max_exhaustive_depth(int p);
 
+	static int dfs_jobs(void);
+	static int dfs_jobs(int p);
+
+	static bool dfs_prune_duplicates(void);
+	static bool dfs_prune_duplicates(bool p);
+
 	static bool compact_output(void);
 	static bool compact_output(bool p);
 
@@ -342,6 +381,24 @@ public:
 	static int stop_by_stmt(void);
 	static int stop_by_stmt(int p);
 
+	static int budget_time(void);
+	static int budget_time(int p);
+
+	static int budget_stmts(void);
+	static int budget_stmts(int p);
+
+	static int budget_fact_iterations(void);
+	static int budget_fact_iterations(int p);
+
+	static int target_min(void);
+	static int target_min(int p);
+
+	static int target_max(void);
+	static int target_max(int p);
+
+	static bool target_stmts(void);
+	static bool target_stmts(bool p);
+
 	static void monitored_funcs(string fnames);
 
 	static bool const_as_condition(void);
@@ -496,11 +553,15 @@ private:
 
 	// Until I do this right, just make them all static.
 	static bool	compute_hash_;
+	static bool	fast_crc_;
+	static bool	block_hash_;
+	static bool	callee_summaries_;
 	static bool	depth_protect_;
 	static int	max_funcs_;
 	static int	max_split_files_;
 	static std::string split_files_dir_;
-	static std::string output_file_;
+	static bool	balance_split_files_;
+	static thread_local std::string output_file_;
 	static int	max_params_;
 	static int	max_block_size_;
 	static int	max_blk_depth_;
@@ -524,15 +585,30 @@ private:
 	static bool paranoid_;
 	static bool quiet_;
 	static bool concise_;
+	static bool fixed_point_stats_;
+	static bool stream_output_;
+	static bool profile_;
+	static bool direct_sampling_;
+	static std::string rng_engine_;
+	static std::string record_trace_;
+	static std::string replay_trace_;
 	static bool nomain_;
 	static bool compound_assignment_;
 	static int stop_by_stmt_;
+	static int budget_time_;
+	static int budget_stmts_;
+	static int budget_fact_iterations_;
+	static int target_min_;
+	static int target_max_;
+	static bool target_stmts_;
 	static bool step_hash_by_stmt_;
 	static bool blind_check_global_;
 	static bool	random_based_;
 	static bool	dfs_exhaustive_;
 	static std::string dfs_debug_sequence_;
 	static int	max_exhaustive_depth_;
+	static int	dfs_jobs_;
+	static bool	dfs_prune_duplicates_;
 	static bool	compact_output_;
 	static int	func1_max_params_;
 	static bool	klee_;
@@ -572,7 +648,7 @@ private:
 	static bool	const_pointers_;
 	static bool	global_variables_;
 	static std::string	vol_tests_mach_;
-	static bool	access_once_;
+	static thread_local bool	access_once_;
 	static bool	strict_volatile_rule_;
 	static bool	addr_taken_of_locals_;
 	static bool	fresh_array_ctrl_var_names_;
@@ -593,7 +669,7 @@ private:
 	static std::string	probability_configuration_;
 
 	static std::string conflict_msg_;
-	static bool match_exact_qualifiers_;
+	static thread_local bool match_exact_qualifiers_;
 
 	static int max_array_num_in_loop_;
 	static bool identify_wrappers_;
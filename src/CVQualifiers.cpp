@@ -338,7 +338,9 @@ CVQualifiers::random_qualifiers(const Type* t, Effect::Access access, const CGCo
 	while (tmp) {   
 		bool volatile_ok = is_volatile_ok_on_one_level(tmp);
 		isVolatile = volatile_ok? rnd_flipcoin(volatile_prob): false;
+		ERROR_GUARD(ret_qfer);
 		isConst = rnd_flipcoin(const_prob);
+		ERROR_GUARD(ret_qfer);
 		if (isVolatile && isConst && !CGOptions::allow_const_volatile()) {
 			isConst = false;
 		}
@@ -354,7 +356,9 @@ CVQualifiers::random_qualifiers(const Type* t, Effect::Access access, const CGCo
 	bool const_ok = (access != Effect::WRITE);
 
 	isVolatile = volatile_ok ? rnd_flipcoin(volatile_prob) : false;
+	ERROR_GUARD(ret_qfer);
 	isConst = const_ok ? rnd_flipcoin(const_prob) : false;
+	ERROR_GUARD(ret_qfer);
 	if (isVolatile && isConst && !CGOptions::allow_const_volatile()) {
 		isConst = false;
 	}
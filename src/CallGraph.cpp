@@ -0,0 +1,91 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "CallGraph.h"
+
+#include <cassert>
+#include <unordered_map>
+
+#include "Block.h"
+#include "Function.h"
+#include "FunctionInvocationUser.h"
+
+using namespace std;
+
+static thread_local unordered_map<const Function*, vector<const Function*> > callees;
+
+void
+CallGraph::add_function(const Function *func)
+{
+	assert(callees.find(func) == callees.end());
+	vector<const FunctionInvocationUser*> calls;
+	func->body->get_called_funcs(calls);
+	vector<const Function*> &funcs = callees[func];
+	calls_to_funcs(calls, funcs);
+	for (size_t i = 0; i < funcs.size(); i++) {
+		// no recursion: a callee is finished before its callers
+		assert(callees.find(funcs[i]) != callees.end());
+	}
+}
+
+const vector<const Function*> &
+CallGraph::get_callees(const Function *func)
+{
+	static thread_local const vector<const Function*> none;
+	unordered_map<const Function*, vector<const Function*> >::const_iterator i = callees.find(func);
+	return i == callees.end() ? none : i->second;
+}
+
+void
+CallGraph::get_reachable(const Function *func, vector<const Function*> &funcs)
+{
+	const vector<const Function*> &direct = get_callees(func);
+	for (size_t i = 0; i < direct.size(); i++) {
+		if (find_function_in_set(funcs, direct[i]) == -1) {
+			funcs.push_back(direct[i]);
+			get_reachable(direct[i], funcs);
+		}
+	}
+}
+
+void
+CallGraph::doFinalization(void)
+{
+	callees.clear();
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,159 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "CallSummaryCache.h"
+
+#include <functional>
+#include <unordered_map>
+
+#include "CGContext.h"
+#include "Fact.h"
+#include "Function.h"
+
+using namespace std;
+
+typedef unordered_multimap<size_t, CallSummary*> Summaries;
+
+static thread_local unordered_map<const Function*, Summaries> summaries;
+
+// few lookups hit, so a function's table stops growing once it is this big
+static const size_t MAX_SUMMARIES_PER_FUNCTION = 32;
+
+static void
+hash_combine(size_t &h, size_t v)
+{
+	h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+}
+
+static void
+hash_vars(size_t &h, const vector<const Variable*> &vars)
+{
+	for (size_t i = 0; i < vars.size(); i++)
+		hash_combine(h, hash<const Variable*>()(vars[i]));
+	hash_combine(h, vars.size());
+}
+
+static bool
+same_effect(const Effect &e1, const Effect &e2)
+{
+	return e1.get_read_vars() == e2.get_read_vars() &&
+		e1.get_write_vars() == e2.get_write_vars() &&
+		e1.get_lhs_write_vars() == e2.get_lhs_write_vars() &&
+		e1.is_pure() == e2.is_pure() &&
+		e1.is_side_effect_free() == e2.is_side_effect_free();
+}
+
+size_t
+CallSummaryCache::hash_key(const vector<const Fact*> &caller_facts,
+						   const vector<const Fact*> &callee_facts, const CGContext &cg_context)
+{
+	size_t h = 0;
+	size_t i;
+	for (i = 0; i < caller_facts.size(); i++)
+		hash_combine(h, caller_facts[i]->hash());
+	hash_combine(h, caller_facts.size());
+	for (i = 0; i < callee_facts.size(); i++)
+		hash_combine(h, callee_facts[i]->hash());
+	hash_combine(h, callee_facts.size());
+	const Effect &context = cg_context.get_effect_context();
+	hash_vars(h, context.get_read_vars());
+	hash_vars(h, context.get_write_vars());
+	for (i = 0; i < cg_context.call_chain.size(); i++)
+		hash_combine(h, hash<const Block*>()(cg_context.call_chain[i]));
+	hash_combine(h, cg_context.flags);
+	return h;
+}
+
+/*
+ * facts are shared (see Fact::share), so the same facts are the same
+ * pointers, in the same order
+ */
+const CallSummary *
+CallSummaryCache::find(const Function *func, const vector<const Fact*> &caller_facts,
+					   const vector<const Fact*> &callee_facts, const CGContext &cg_context)
+{
+	unordered_map<const Function*, Summaries>::iterator f = summaries.find(func);
+	if (f == summaries.end())
+		return NULL;
+	size_t h = hash_key(caller_facts, callee_facts, cg_context);
+	pair<Summaries::iterator, Summaries::iterator> range = f->second.equal_range(h);
+	for (Summaries::iterator i = range.first; i != range.second; ++i) {
+		const CallSummary *s = i->second;
+		if (s->caller_facts == caller_facts && s->callee_facts == callee_facts &&
+			s->flags == cg_context.flags && s->call_chain == cg_context.call_chain &&
+			same_effect(s->effect_context, cg_context.get_effect_context())) {
+			return s;
+		}
+	}
+	return NULL;
+}
+
+void
+CallSummaryCache::add(const Function *func, const vector<const Fact*> &caller_facts,
+					  const vector<const Fact*> &callee_facts, const CGContext &cg_context,
+					  bool ok, const vector<const Fact*> &facts_out,
+					  const vector<const Fact*> &ret_facts, const Effect &effect)
+{
+	Summaries &table = summaries[func];
+	if (table.size() >= MAX_SUMMARIES_PER_FUNCTION)
+		return;
+	CallSummary *s = new CallSummary();
+	s->caller_facts = caller_facts;
+	s->callee_facts = callee_facts;
+	s->effect_context = cg_context.get_effect_context();
+	s->call_chain = cg_context.call_chain;
+	s->flags = cg_context.flags;
+	s->ok = ok;
+	s->facts_out = facts_out;
+	s->ret_facts = ret_facts;
+	s->effect = effect;
+	table.insert(make_pair(hash_key(caller_facts, callee_facts, cg_context), s));
+}
+
+void
+CallSummaryCache::doFinalization(void)
+{
+	unordered_map<const Function*, Summaries>::iterator f;
+	for (f = summaries.begin(); f != summaries.end(); ++f) {
+		for (Summaries::iterator i = f->second.begin(); i != f->second.end(); ++i)
+			delete i->second;
+	}
+	summaries.clear();
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,94 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef CALL_SUMMARY_CACHE_H
+#define CALL_SUMMARY_CACHE_H
+
+#include <vector>
+#include "Effect.h"
+
+class Block;
+class CGContext;
+class Fact;
+class Function;
+
+/*
+ * The outcome of analyzing a callee for one call: whether the call is
+ * valid, the caller's facts after it, the facts on the return value and the
+ * effect of the call.
+ */
+struct CallSummary
+{
+	// what the analysis depends on
+	std::vector<const Fact*> caller_facts;
+	std::vector<const Fact*> callee_facts;
+	Effect effect_context;
+	std::vector<const Block*> call_chain;
+	unsigned int flags;
+
+	bool ok;
+	std::vector<const Fact*> facts_out;
+	std::vector<const Fact*> ret_facts;
+	Effect effect;
+};
+
+/*
+ * Summaries of callee re-analyses, per function. A call that hands the
+ * callee the same facts, under the same effect context and call chain, as
+ * an earlier call gets the earlier result instead of going through the
+ * body again. Each function keeps a bounded number of summaries. Used with
+ * --callee-summaries.
+ */
+class CallSummaryCache
+{
+public:
+	// the summary of an earlier call to <func> with the same inputs, NULL if none
+	static const CallSummary *find(const Function *func, const std::vector<const Fact*> &caller_facts,
+								   const std::vector<const Fact*> &callee_facts, const CGContext &cg_context);
+
+	static void add(const Function *func, const std::vector<const Fact*> &caller_facts,
+					const std::vector<const Fact*> &callee_facts, const CGContext &cg_context,
+					bool ok, const std::vector<const Fact*> &facts_out,
+					const std::vector<const Fact*> &ret_facts, const Effect &effect);
+
+	static void doFinalization(void);
+
+private:
+	static size_t hash_key(const std::vector<const Fact*> &caller_facts,
+						   const std::vector<const Fact*> &callee_facts, const CGContext &cg_context);
+};
+
+#endif // CALL_SUMMARY_CACHE_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
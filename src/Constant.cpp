@@ -439,6 +439,7 @@ GenerateRandomConstant(const Type* type)
 Constant *
 Constant::make_random(const Type* type)
 {
+	RandomStreamScope stream(rsConstants);
 	string v = GenerateRandomConstant(type);
 	ERROR_GUARD(NULL);
 	return new Constant(type, v);
@@ -447,6 +448,7 @@ Constant::make_random(const Type* type)
 Constant *
 Constant::make_random_upto(unsigned int limit)
 {
+	RandomStreamScope stream(rsConstants);
 	ostringstream oss;
 	oss << rnd_upto(limit);
 	ERROR_GUARD(NULL);
@@ -456,6 +458,7 @@ Constant::make_random_upto(unsigned int limit)
 Constant*
 Constant::make_random_nonzero(const Type* type)
 {
+	RandomStreamScope stream(rsConstants);
 	string v = GenerateRandomConstant(type);
 	ERROR_GUARD(NULL);
 	while (StringUtils::str2int(v) == 0) {
@@ -77,7 +77,7 @@ CoverageTestExtension::output_array_init(std::ostream &out, int count)
 	int last_index = inputs_size_ + count - 1;
 	for (int i = count; i < last_index; ++i) {
 		if ((len % 10) == 0) {
-			out << std::endl;
+			out << '\n';
 			out << AbsExtension::tab_ << AbsExtension::tab_;
 		}
 		test_values_[i]->Output(out);
@@ -85,7 +85,7 @@ CoverageTestExtension::output_array_init(std::ostream &out, int count)
 		len++;
 	}
 	if ((len % 10) == 0) {
-		out << std::endl;
+		out << '\n';
 		out << AbsExtension::tab_ << AbsExtension::tab_;
 	}
 	test_values_[last_index]->Output(out);
@@ -103,38 +103,38 @@ CoverageTestExtension::output_decls(std::ostream &out)
 		out << " " << CoverageTestExtension::array_base_name_ << count;
 		out << "[" << inputs_size_ << "] = {";
 		output_array_init(out, count);
-		out << "};" << std::endl;
+		out << "};" << '\n';
 		count++;
 	}
-	out << AbsExtension::tab_ << "int " << array_index_ << ";" << std::endl;
+	out << AbsExtension::tab_ << "int " << array_index_ << ";" << '\n';
 }
 
 void
 CoverageTestExtension::OutputFirstFunInvocation(std::ostream &out, FunctionInvocation *invoke)
 {
 	out << AbsExtension::tab_ << "for(" << array_index_ << " = 0; ";
-	out << array_index_ << " < " << inputs_size_ << "; " << array_index_ << "++) {" << std::endl;
+	out << array_index_ << " < " << inputs_size_ << "; " << array_index_ << "++) {" << '\n';
 	vector<ExtensionValue *>::iterator i;
 	int count = 0;
 	for (i = values_.begin(); i != values_.end(); ++i) {
 		out << AbsExtension::tab_ << AbsExtension::tab_;
 		out << (*i)->get_name() << " = ";
 		out << CoverageTestExtension::array_base_name_ << count;
-		out << "[" << array_index_ << "];" << std::endl;
+		out << "[" << array_index_ << "];" << '\n';
 		count++;
 	}
 	assert(invoke);
 	out << AbsExtension::tab_ << AbsExtension::tab_;
 	invoke->Output(out);
-	out << ";" << std::endl;
-	out << AbsExtension::tab_ << "}" << std::endl;
+	out << ";" << '\n';
+	out << AbsExtension::tab_ << "}" << '\n';
 }
 
 void
 CoverageTestExtension::OutputInit(std::ostream &out)
 {
-	out << "int main(void)" << endl;
-	out << "{" << endl;
+	out << "int main(void)" << '\n';
+	out << "{" << '\n';
 	output_decls(out);
 	//output_array_init(out);
 }
@@ -148,6 +148,6 @@ CoverageTestExtension::OutputHeader(std::ostream &)
 void
 CoverageTestExtension::OutputTail(std::ostream &out)
 {
-	out << AbsExtension::tab_ << "return 0;" << endl;
+	out << AbsExtension::tab_ << "return 0;" << '\n';
 }
 
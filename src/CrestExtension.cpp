@@ -83,15 +83,15 @@ CrestExtension::output_symbolics(ostream &out)
 		assert(*i);
 		out << AbsExtension::tab_;
 		out << CrestExtension::input_base_name_ << type_to_string((*i)->get_type());
-		out << "(" << (*i)->get_name() << ");" << std::endl;
+		out << "(" << (*i)->get_name() << ");" << '\n';
 	}
 }
 
 void
 CrestExtension::OutputInit(std::ostream &out)
 {
-	out << "int main(void)" << endl;
-	out << "{" << endl;
+	out << "int main(void)" << '\n';
+	out << "{" << '\n';
 	AbsExtension::default_output_definitions(out, values_, false);
 	output_symbolics(out);
 }
@@ -99,13 +99,13 @@ CrestExtension::OutputInit(std::ostream &out)
 void
 CrestExtension::OutputHeader(std::ostream &out)
 {
-	out << "#include \"crest.h\"" << endl;
+	out << "#include \"crest.h\"" << '\n';
 }
 
 void
 CrestExtension::OutputTail(std::ostream &out)
 {
-	out << AbsExtension::tab_ << "return 0;" << endl;
+	out << AbsExtension::tab_ << "return 0;" << '\n';
 }
 
 void
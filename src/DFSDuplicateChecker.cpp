@@ -0,0 +1,132 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "DFSDuplicateChecker.h"
+
+#include <cassert>
+#include <sstream>
+#include <unordered_map>
+
+#include "CGOptions.h"
+#include "DFSRndNumGenerator.h"
+#include "Error.h"
+#include "Function.h"
+#include "OutputMgr.h"
+#include "RandomNumber.h"
+#include "VariableSelector.h"
+
+using namespace std;
+
+// canonical text of a program reached by the search -> the shallowest
+// position it was reached at. the text itself is the key, so that two
+// programs whose hashes collide are still told apart
+static thread_local unordered_map<string, int> seen_programs;
+
+static thread_local unsigned long checks = 0;
+
+static thread_local unsigned long pruned = 0;
+
+void
+DFSDuplicateChecker::canonical_text(std::ostream &out)
+{
+	OutputMgr::set_canonical_output(true);
+	OutputGlobalVariables(out);
+	const vector<Function*> &funcs = get_all_functions();
+	for (size_t i = 0; i < funcs.size(); i++) {
+		if (funcs[i]->is_built())
+			funcs[i]->Output(out);
+		else
+			funcs[i]->OutputForwardDecl(out);
+	}
+	OutputMgr::set_canonical_output(false);
+}
+
+void
+DFSDuplicateChecker::check_program(void)
+{
+	DFSRndNumGenerator *impl =
+		dynamic_cast<DFSRndNumGenerator*>(RandomNumber::GetRndNumGenerator());
+	assert(impl);
+	// only the paths that have just made a new decision are worth a look,
+	// the others are replaying a prefix checked already
+	int pos = impl->get_current_pos();
+	if (Error::get_error() != SUCCESS || pos != impl->get_decision_depth())
+		return;
+
+	ostringstream ss;
+	canonical_text(ss);
+	prune_if_seen(impl, ss.str());
+}
+
+void
+DFSDuplicateChecker::prune_if_seen(DFSRndNumGenerator *impl, const std::string &text)
+{
+	int pos = impl->get_current_pos();
+	checks++;
+
+	unordered_map<string, int>::iterator i = seen_programs.find(text);
+	if (i == seen_programs.end()) {
+		seen_programs[text] = pos;
+	}
+	else if (i->second > pos) {
+		// reached with more depth left than before, search it again
+		i->second = pos;
+	}
+	else if (impl->prune_subtree()) {
+		pruned++;
+	}
+}
+
+void
+DFSDuplicateChecker::OutputStatistics(std::ostream &out)
+{
+	out << "/* --- DUPLICATE PRUNING --- */" << '\n';
+	out << "/* checked programs:   " << checks << " */" << '\n';
+	out << "/* distinct programs:  " << seen_programs.size() << " */" << '\n';
+	out << "/* pruned subtrees:    " << pruned << " */" << '\n';
+}
+
+void
+DFSDuplicateChecker::doFinalization(void)
+{
+	seen_programs.clear();
+	checks = 0;
+	pruned = 0;
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,70 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DFS_DUPLICATE_CHECKER_H
+#define DFS_DUPLICATE_CHECKER_H
+
+#include <ostream>
+#include <string>
+
+class DFSRndNumGenerator;
+
+/*
+ * Prunes the subtrees of the exhaustive search that can only lead to
+ * programs already enumerated. Whenever a function is complete, the program
+ * generated so far is printed in a canonical form (no name prefixes, the
+ * operands of commutative operators sorted) and looked up. A path reaching a
+ * program already reached by an earlier path, no deeper in the search,
+ * cannot produce anything new, and the search moves on to the next sibling.
+ */
+class DFSDuplicateChecker
+{
+public:
+	// Check the program generated so far, and prune the current subtree if
+	// it is a duplicate. Sets BACKTRACKING_ERROR when pruning.
+	static void check_program(void);
+
+	static void OutputStatistics(std::ostream &out);
+
+	static void doFinalization(void);
+
+private:
+	static void canonical_text(std::ostream &out);
+
+	static void prune_if_seen(DFSRndNumGenerator *impl, const std::string &text);
+};
+
+#endif // DFS_DUPLICATE_CHECKER_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -42,7 +42,9 @@
 
 using namespace std;
 
-DFSOutputMgr *DFSOutputMgr::instance_ = NULL;
+thread_local DFSOutputMgr *DFSOutputMgr::instance_ = NULL;
+
+thread_local std::ostream *DFSOutputMgr::main_out_ = NULL;
 
 DFSOutputMgr::DFSOutputMgr()
 {
@@ -51,7 +53,8 @@ DFSOutputMgr::DFSOutputMgr()
 
 DFSOutputMgr::~DFSOutputMgr()
 {
-
+	if (instance_ == this)
+		instance_ = NULL;
 }
 
 DFSOutputMgr *
@@ -71,6 +74,12 @@ DFSOutputMgr::CreateInstance()
 	return DFSOutputMgr::instance_;
 }
 
+void
+DFSOutputMgr::set_main_out(std::ostream *out)
+{
+	main_out_ = out;
+}
+
 void
 DFSOutputMgr::OutputHeader(int argc, char *argv[], unsigned long seed)
 {
@@ -108,6 +117,8 @@ DFSOutputMgr::Output()
 std::ostream &
 DFSOutputMgr::get_main_out()
 {
+	if (main_out_)
+		return *main_out_;
 	return std::cout;
 }
 
@@ -115,7 +126,7 @@ void
 DFSOutputMgr::outputln(ostream &out)
 {
 	if (!CGOptions::compact_output())
-		out << std::endl;
+		out << '\n';
 }
 
 void
@@ -38,6 +38,8 @@ class DFSOutputMgr : public OutputMgr {
 public:
 	static DFSOutputMgr *CreateInstance();
 
+	static void set_main_out(std::ostream *out);
+
 	virtual ~DFSOutputMgr();
 
 	virtual void OutputHeader(int argc, char *argv[], unsigned long seed);
@@ -57,7 +59,10 @@ private:
 
 	virtual std::ostream &get_main_out();
 
-	static DFSOutputMgr *instance_;
+	static thread_local DFSOutputMgr *instance_;
+
+	// where the programs go, std::cout unless set (per thread)
+	static thread_local std::ostream *main_out_;
 
 	std::string struct_output_;
 };
@@ -35,16 +35,24 @@
 #include <cassert>
 #include <iostream>
 #include <sstream>
+#include <deque>
+#include <list>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include "RandomNumber.h"
 #include "AbsRndNumGenerator.h"
 #include "DFSRndNumGenerator.h"
 #include "DFSOutputMgr.h"
+#include "DFSDuplicateChecker.h"
 #include "Finalization.h"
 #include "Error.h"
 #include "Function.h"
 #include "VariableSelector.h"
 #include "util.h"
 #include "PartialExpander.h"
+#include "Profiler.h"
+#include "CGOptions.h"
 
 using namespace std;
 
@@ -80,32 +88,220 @@ DFSProgramGenerator::get_count_prefix(const std::string &name)
 	return ss.str();
 }
 
+/*
+ * Generate the program of the next path of the search, if it leads to one,
+ * and make ready for the path after it.
+ */
+void
+DFSProgramGenerator::generate_next(DFSRndNumGenerator *impl, std::ostream &out)
+{
+	Error::set_error(SUCCESS);
+	GenerateFunctions();
+	if (Error::get_error() == SUCCESS) {
+		ProfileScope scope(Profiler::pOutput);
+		output_mgr_->OutputHeader(argc_, argv_, seed_);
+		output_mgr_->Output();
+		OutputMgr::really_outputln(out);
+		out.flush();
+		good_count_++;
+	}
+	impl->reset_state();
+	Function::doFinalization();
+	VariableSelector::doFinalization();
+	reset_gensym();
+	PartialExpander::restore_init_values();
+}
+
 void
 DFSProgramGenerator::goGenerator()
 {
 	DFSRndNumGenerator *impl =
 		dynamic_cast<DFSRndNumGenerator*>(RandomNumber::GetRndNumGenerator());
-	//unsigned long long count = 0;
-	GenerateAllTypes();
+	Profiler::start();
+	{
+		ProfileScope scope(Profiler::pTypes);
+		GenerateAllTypes();
+	}
+	// the types are generated once, only the functions are enumerated
+	impl->set_base();
 	output_mgr_->OutputStructUnions(cout);
-	while(!impl->get_all_done()) {
-		Error::set_error(SUCCESS);
-		GenerateFunctions();
-		if (Error::get_error() == SUCCESS) {
-			//count++;
-			//if (count >= 47376)
-				//cout << "here" << std::endl;
-			output_mgr_->OutputHeader(argc_, argv_, seed_);
-			output_mgr_->Output();
-			OutputMgr::really_outputln(cout);
-			good_count_++;
+	if (CGOptions::dfs_jobs() > 1) {
+		enumerate_parallel();
+	}
+	else {
+		while(!impl->get_all_done()) {
+			generate_next(impl, cout);
 		}
-		impl->reset_state();
-		Function::doFinalization();
-		VariableSelector::doFinalization();
-		reset_gensym();
-		PartialExpander::restore_init_values();
-		//cout << "count = " << count << std::endl;
 	}
+	if (CGOptions::dfs_prune_duplicates())
+		DFSDuplicateChecker::OutputStatistics(cout);
+	// one profile for the whole enumeration
+	if (CGOptions::profile())
+		Profiler::OutputProfile(cout);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * The output of one task, kept in the order in which the serial search
+ * would have produced it.
+ */
+struct DFSSegment {
+	std::string text;
+	bool finished;
+};
+
+/*
+ * A subtree of the search: the decisions after the types are fixed to
+ * prefix, and the next one ranges over [lo, hi).
+ */
+struct DFSTask {
+	std::vector<int> prefix;
+	int lo;
+	int hi;
+	std::list<DFSSegment>::iterator segment;
+};
+
+/*
+ * The state shared by the workers of a parallel enumeration. A worker that
+ * runs out of tasks waits; the busy ones notice it between two programs and
+ * give away the upper half of what is left at their shallowest open
+ * decision. That part of the search comes right after the rest of the
+ * giver's, so its segment goes right after the giver's segment.
+ */
+struct DFSWork {
+	std::mutex mutex;
+	std::condition_variable cond;
+	std::deque<DFSTask> tasks;			// not started yet
+	std::list<DFSSegment> segments;		// not written yet
+	int workers;
+	int idle;							// workers waiting for a task
+	bool done;
+};
+
+static bool
+take_task(DFSWork *work, DFSTask &task)
+{
+	std::unique_lock<std::mutex> lock(work->mutex);
+	work->idle++;
+	for (;;) {
+		if (!work->tasks.empty()) {
+			task = work->tasks.front();
+			work->tasks.pop_front();
+			work->idle--;
+			return true;
+		}
+		if (work->done)
+			return false;
+		if (work->idle == work->workers) {
+			work->done = true;
+			work->cond.notify_all();
+			return false;
+		}
+		work->cond.wait(lock);
+	}
+}
+
+/*
+ * Run the tasks of a parallel enumeration in this thread, splitting the
+ * current one whenever another worker is waiting.
+ */
+void
+DFSProgramGenerator::run_tasks(DFSWork *work)
+{
+	DFSRndNumGenerator *impl =
+		dynamic_cast<DFSRndNumGenerator*>(RandomNumber::GetRndNumGenerator());
+	PartialExpander::restore_init_values();
+	GenerateAllTypes();
+	impl->set_base();
+
+	std::ostringstream out;
+	DFSOutputMgr::set_main_out(&out);
+	DFSTask task;
+	while (take_task(work, task)) {
+		impl->start_task(task.prefix, task.lo, task.hi);
+		while (!impl->get_all_done()) {
+			generate_next(impl, out);
+			std::lock_guard<std::mutex> lock(work->mutex);
+			if (out.tellp() > 0) {
+				task.segment->text += out.str();
+				out.str("");
+				work->cond.notify_all();
+			}
+			if (work->idle > 0 && work->tasks.empty()) {
+				DFSTask t;
+				if (impl->split_task(t.prefix, t.lo, t.hi)) {
+					std::list<DFSSegment>::iterator next = task.segment;
+					t.segment = work->segments.insert(++next, DFSSegment());
+					t.segment->finished = false;
+					work->tasks.push_back(t);
+					work->cond.notify_all();
+				}
+			}
+		}
+		std::lock_guard<std::mutex> lock(work->mutex);
+		task.segment->finished = true;
+		work->cond.notify_all();
+	}
+	DFSOutputMgr::set_main_out(NULL);
+}
+
+static void
+dfs_worker(int argc, char **argv, unsigned long seed, DFSWork *work,
+		   bool access_once, bool match_exact_qualifiers)
+{
+	// the options changed while generating are per thread, start from the parsed ones
+	CGOptions::access_once(access_once);
+	CGOptions::match_exact_qualifiers(match_exact_qualifiers);
+
+	AbsProgramGenerator *generator = AbsProgramGenerator::CreateInstance(argc, argv, seed);
+	assert(generator);
+	static_cast<DFSProgramGenerator*>(generator)->run_tasks(work);
+	delete generator;
+}
+
+/*
+ * Enumerate with --jobs threads, each with its own copy of the generator
+ * state, and write the programs in the serial order as they come in.
+ */
+void
+DFSProgramGenerator::enumerate_parallel(void)
+{
+	DFSWork work;
+	work.workers = CGOptions::dfs_jobs();
+	work.idle = 0;
+	work.done = false;
+
+	DFSTask root;
+	root.lo = 0;
+	root.hi = -1;
+	root.segment = work.segments.insert(work.segments.end(), DFSSegment());
+	root.segment->finished = false;
+	work.tasks.push_back(root);
+
+	vector<std::thread> workers;
+	for (int i = 0; i < work.workers; i++) {
+		workers.push_back(std::thread(dfs_worker, argc_, argv_, seed_, &work,
+			CGOptions::access_once(), CGOptions::match_exact_qualifiers()));
+	}
+	for (;;) {
+		std::string text;
+		{
+			std::unique_lock<std::mutex> lock(work.mutex);
+			work.cond.wait(lock, [&work] {
+				return work.segments.empty() ? work.done :
+					(!work.segments.front().text.empty() || work.segments.front().finished);
+			});
+			if (work.segments.empty())
+				break;
+			text.swap(work.segments.front().text);
+			if (work.segments.front().finished)
+				work.segments.pop_front();
+		}
+		cout << text;
+		cout.flush();
+	}
+	for (size_t i = 0; i < workers.size(); i++) {
+		workers[i].join();
+	}
+}
@@ -34,6 +34,8 @@
 #include "Common.h"
 
 class OutputMgr;
+class DFSRndNumGenerator;
+struct DFSWork;
 
 class DFSProgramGenerator : public AbsProgramGenerator {
 public:
@@ -49,7 +51,13 @@ public:
 
 	virtual std::string get_count_prefix(const std::string &name);
 
+	void run_tasks(DFSWork *work);
+
 private:
+	void generate_next(DFSRndNumGenerator *impl, std::ostream &out);
+
+	void enumerate_parallel(void);
+
 	int argc_;
 
 	char **argv_;
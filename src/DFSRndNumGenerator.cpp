@@ -66,6 +66,12 @@ public:
 	int bound() { return bound_; }
 	void set_bound(int bound) { bound_ = bound; }
 
+	int limit() { return limit_; }
+	void set_limit(int limit) { limit_ = limit; }
+
+	// the bound to enumerate against, narrowed by the limit of a split task
+	int upper(int bound) { return (limit_ >= 0 && limit_ < bound) ? limit_ : bound; }
+
 	int index() { return index_; }
 
 private:
@@ -76,6 +82,10 @@ private:
 
 	int bound_;
 
+	// Exclusive upper value for this node when the subtree above it was
+	// split between workers, -1 if none
+	int limit_;
+
 	int index_;
 };
 
@@ -86,6 +96,7 @@ DFSRndNumGenerator::SearchState::SearchState(int index)
 	: init_(false),
 	  value_(0),
 	  bound_(0),
+	  limit_(-1),
 	  index_(index)
 {
 	// Nothing to do
@@ -95,6 +106,7 @@ DFSRndNumGenerator::SearchState::SearchState(const DFSRndNumGenerator::SearchSta
 	: init_(state.init_),
 	  value_(state.value_),
 	  bound_(state.bound_),
+	  limit_(state.limit_),
 	  index_(state.index_)
 {
 
@@ -116,6 +128,7 @@ DFSRndNumGenerator::SearchState::initSearchState(bool init, int value, int bound
 	init_ = init;
 	value_ = value;
 	bound_ = bound;
+	limit_ = -1;
 }
 
 #define DEBUG
@@ -132,12 +145,14 @@ void DFSRndNumGenerator::SearchState::dump(const string &)
 #endif
 // ----------------------------------------------------------------------------------------------
 
-DFSRndNumGenerator *DFSRndNumGenerator::impl_ = 0;
+thread_local DFSRndNumGenerator *DFSRndNumGenerator::impl_ = 0;
 
 DFSRndNumGenerator::DFSRndNumGenerator(Sequence *concrete_seq)
 	: trace_string_(""),
 	  decision_depth_(-1),
 	  current_pos_(-1),
+	  base_pos_(-1),
+	  floor_(0),
 	  all_done_(false),
 	  seq_(concrete_seq),
 	  use_debug_sequence_(false)
@@ -153,6 +168,8 @@ DFSRndNumGenerator::~DFSRndNumGenerator()
 	}
 	states_.clear();
 	SequenceFactory::destroy_sequences();
+	if (impl_ == this)
+		impl_ = 0;
 }
 
 /*
@@ -214,7 +231,13 @@ DFSRndNumGenerator::dumpCurrentState(int, const string &)
 bool
 DFSRndNumGenerator::eager_backtracking(int depth_needed)
 {
-	if (current_pos_ <= 0) {
+	if (current_pos_ < floor_ && current_pos_ > base_pos_ + 1) {
+		// the rest of this task lies in the pruned subtree
+		all_done_ = true;
+		Error::set_error(BACKTRACKING_ERROR);
+		return true;
+	}
+	if (current_pos_ <= base_pos_ + 1) {
 		// all_done_ = true;
 		// Error::set_error(BACKTRACKING_ERROR);
 		// return true;
@@ -319,6 +342,7 @@ DFSRndNumGenerator::random_choice (int bound, const Filter *filter, const string
 
 	if (state->init()) {
 		int v = state->value();
+		int upper = state->upper(bound);
 		int local_decision_depth = decision_depth_;
 		do { // Filter out invalid value
 			++v;
@@ -326,17 +350,17 @@ DFSRndNumGenerator::random_choice (int bound, const Filter *filter, const string
 			current_pos_ = local_current_pos;
 			decision_depth_ = local_decision_depth;
 			ERROR_GUARD(-1);
-		} while (v < bound && ((filter && filter->filter(v)) || filter_invalid_nums(invalid_nums, v)));
+		} while (v < upper && ((filter && filter->filter(v)) || filter_invalid_nums(invalid_nums, v)));
 
 		state->set_value(v);
 
-		if (state->value() >= bound) { // backtracking
+		if (state->value() >= upper) { // backtracking
 			current_pos_ = local_current_pos;
 			for (int i = current_pos_; i < CGOptions::max_exhaustive_depth(); ++i) {
 				states_[i]->set_init(false);
 			}
 			--decision_depth_;
-			if (decision_depth_ < 0)
+			if (decision_depth_ < floor_)
 				all_done_ = true;
 			Error::set_error(BACKTRACKING_ERROR);
 			return -1;
@@ -372,7 +396,7 @@ DFSRndNumGenerator::random_choice (int bound, const Filter *filter, const string
 				states_[i]->set_init(false);
 			}
 			--decision_depth_;
-			if (decision_depth_ < 0)
+			if (decision_depth_ < floor_)
 				all_done_ = true;
 			Error::set_error(BACKTRACKING_ERROR);
 			return -1;
@@ -415,11 +439,99 @@ DFSRndNumGenerator::init_states(int size)
 void
 DFSRndNumGenerator::reset_state(void)
 {
-	current_pos_ = -1;
+	current_pos_ = base_pos_;
 	trace_string_ = "";
 	seq_->clear();
 }
 
+/*
+ * Called once the decisions made so far (the types, which are generated only
+ * once) should stay fixed: the search backtracks no further than this point,
+ * and later programs make their choices from the next position on.
+ */
+void
+DFSRndNumGenerator::set_base(void)
+{
+	if (use_debug_sequence_)
+		return;
+	base_pos_ = current_pos_;
+	floor_ = base_pos_ + 1;
+	decision_depth_ = base_pos_;
+	seq_->clear();
+}
+
+/*
+ * Restrict the search to one task: the decisions after the base are fixed
+ * to prefix, and the next one enumerates the values in [lo, hi), or every
+ * value if hi is -1.
+ */
+void
+DFSRndNumGenerator::start_task(const std::vector<int> &prefix, int lo, int hi)
+{
+	int max_depth = CGOptions::max_exhaustive_depth();
+	int pos = base_pos_ + 1;
+
+	assert(pos + static_cast<int>(prefix.size()) < max_depth);
+	for (int i = pos; i < max_depth; ++i)
+		states_[i]->initSearchState(false, 0, 0);
+	for (size_t i = 0; i < prefix.size(); ++i, ++pos)
+		states_[pos]->initSearchState(true, prefix[i], 0);
+	// the first run increments this to lo
+	states_[pos]->initSearchState(true, lo - 1, 0);
+	states_[pos]->set_limit(hi);
+
+	decision_depth_ = pos;
+	floor_ = pos;
+	current_pos_ = base_pos_;
+	all_done_ = false;
+}
+
+/*
+ * Give away the upper half of the values not yet tried at the shallowest
+ * decision that still has some. On success, the new task is returned through
+ * prefix, lo and hi, and this search stops short of it. Only valid between
+ * two programs.
+ */
+bool
+DFSRndNumGenerator::split_task(std::vector<int> &prefix, int &lo, int &hi)
+{
+	if (all_done_ || use_debug_sequence_)
+		return false;
+	for (int j = floor_; j <= decision_depth_; ++j) {
+		SearchState *state = states_[j];
+		if (!state->init() || state->bound() <= 0)
+			return false;
+		int upper = state->upper(state->bound());
+		int remain = upper - (state->value() + 1);
+		if (remain <= 0)
+			continue;
+		int mid = upper - (remain + 1) / 2;
+		prefix.clear();
+		for (int i = base_pos_ + 1; i < j; ++i)
+			prefix.push_back(states_[i]->value());
+		lo = mid;
+		hi = upper;
+		state->set_limit(mid);
+		return true;
+	}
+	return false;
+}
+
+/*
+ * Skip the rest of the subtree below the last decision, which must have just
+ * been made, and go on with its next value.
+ */
+bool
+DFSRndNumGenerator::prune_subtree(void)
+{
+	if (use_debug_sequence_ || current_pos_ < floor_ || current_pos_ != decision_depth_)
+		return false;
+	for (int i = current_pos_ + 1; i < CGOptions::max_exhaustive_depth(); ++i)
+		states_[i]->set_init(false);
+	Error::set_error(BACKTRACKING_ERROR);
+	return true;
+}
+
 /*
  *
  */
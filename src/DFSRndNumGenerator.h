@@ -75,6 +75,14 @@ public:
 
 	bool get_all_done(void) { return all_done_; }
 
+	void set_base(void);
+
+	void start_task(const std::vector<int> &prefix, int lo, int hi);
+
+	bool split_task(std::vector<int> &prefix, int &lo, int &hi);
+
+	bool prune_subtree(void);
+
 private:
 	// Forward declaration of nested class SearchState;
 	class SearchState;
@@ -100,7 +108,7 @@ private:
 	void log_depth(int d, const std::string *where = NULL, const char *log = NULL);
 
 	// ----------------------------------------------------------------------------------------
-	static DFSRndNumGenerator *impl_;
+	static thread_local DFSRndNumGenerator *impl_;
 
 	//static std::string name_prefix;
 
@@ -113,6 +121,12 @@ private:
 	// The current position at states.
 	int current_pos_;
 
+	// The last position of the decisions that are never revisited (types)
+	int base_pos_;
+
+	// The search is done once it backtracks below this position
+	int floor_;
+
 	bool all_done_;
 
 	Sequence *seq_;
@@ -0,0 +1,258 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "DecisionTrace.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#if HAVE_SYS_MMAN_H
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+using namespace std;
+
+static const char trace_magic[] = "CSMTRACE";
+static const size_t trace_magic_len = sizeof(trace_magic) - 1;
+static const unsigned INT64 trace_version = 1;
+
+DecisionTrace *DecisionTrace::instance_ = NULL;
+
+DecisionTrace::DecisionTrace(const string &file, bool replaying, unsigned long seed)
+	: file_(file),
+	  replaying_(replaying),
+	  seed_(seed),
+	  count_(0),
+	  data_(NULL),
+	  size_(0),
+	  mapped_(false),
+	  cur_(NULL),
+	  end_(NULL),
+	  remaining_(0)
+{
+}
+
+DecisionTrace::~DecisionTrace(void)
+{
+#if HAVE_SYS_MMAN_H
+	if (mapped_)
+		munmap(const_cast<unsigned char *>(data_), size_);
+#endif
+}
+
+/*
+ * Start recording the decisions of the program of <seed> into <file>. The
+ * file is written when the program is done (see doFinalization).
+ */
+DecisionTrace *
+DecisionTrace::CreateRecorder(const string &file, unsigned long seed)
+{
+	assert(!instance_);
+	instance_ = new DecisionTrace(file, false, seed);
+	return instance_;
+}
+
+/*
+ * Open <file> for replaying. Return NULL and the reason in <err> if it is
+ * not a trace.
+ */
+DecisionTrace *
+DecisionTrace::OpenReplay(const string &file, string &err)
+{
+	assert(!instance_);
+	DecisionTrace *trace = new DecisionTrace(file, true, 0);
+	if (!trace->map_file(err)) {
+		delete trace;
+		return NULL;
+	}
+
+	unsigned INT64 version = 0, seed = 0;
+	if (trace->size_ < trace_magic_len ||
+		memcmp(trace->data_, trace_magic, trace_magic_len) != 0) {
+		err = file + " is not a csmith trace";
+	}
+	else {
+		trace->cur_ += trace_magic_len;
+		if (!trace->get_varint(version) || version != trace_version)
+			err = file + " has an unknown trace version";
+		else if (!trace->get_varint(seed) || !trace->get_varint(trace->remaining_))
+			err = file + " is truncated";
+	}
+	if (!err.empty()) {
+		delete trace;
+		return NULL;
+	}
+	trace->seed_ = static_cast<unsigned long>(seed);
+	instance_ = trace;
+	return instance_;
+}
+
+bool
+DecisionTrace::map_file(string &err)
+{
+#if HAVE_SYS_MMAN_H
+	int fd = open(file_.c_str(), O_RDONLY);
+	if (fd < 0) {
+		err = "can't open " + file_;
+		return false;
+	}
+	struct stat st;
+	if (fstat(fd, &st) == 0 && st.st_size > 0) {
+		void *p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p != MAP_FAILED) {
+			// the decisions are read once, front to back
+			madvise(p, st.st_size, MADV_SEQUENTIAL);
+			data_ = static_cast<const unsigned char *>(p);
+			size_ = st.st_size;
+			mapped_ = true;
+		}
+	}
+	close(fd);
+	if (mapped_) {
+		cur_ = data_;
+		end_ = data_ + size_;
+		return true;
+	}
+#endif
+	// no mmap, read the whole file
+	ifstream in(file_.c_str(), ios_base::in | ios_base::binary);
+	if (!in) {
+		err = "can't open " + file_;
+		return false;
+	}
+	buf_.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+	data_ = buf_.empty() ? NULL : &buf_[0];
+	size_ = buf_.size();
+	cur_ = data_;
+	end_ = data_ + size_;
+	return true;
+}
+
+void
+DecisionTrace::put_varint(vector<unsigned char> &buf, unsigned INT64 v)
+{
+	while (v >= 0x80) {
+		buf.push_back(static_cast<unsigned char>(v | 0x80));
+		v >>= 7;
+	}
+	buf.push_back(static_cast<unsigned char>(v));
+}
+
+bool
+DecisionTrace::get_varint(unsigned INT64 &v)
+{
+	v = 0;
+	for (int shift = 0; cur_ < end_ && shift < 64; shift += 7) {
+		unsigned char c = *cur_++;
+		v |= static_cast<unsigned INT64>(c & 0x7F) << shift;
+		if (!(c & 0x80))
+			return true;
+	}
+	return false;
+}
+
+void
+DecisionTrace::record(unsigned int v)
+{
+	assert(!replaying_);
+	put_varint(buf_, v);
+	count_++;
+}
+
+/*
+ * Return the next decision, which must be below <bound>. Anything else means
+ * the program being generated is not the one recorded, and we give up.
+ */
+unsigned int
+DecisionTrace::next(unsigned int bound)
+{
+	assert(replaying_);
+	unsigned INT64 v = 0;
+	if (remaining_ == 0 || !get_varint(v) || v >= bound) {
+		cerr << "error: " << file_ << " does not match this program, "
+			 << "it must be replayed with the options it was recorded with" << std::endl;
+		exit(-1);
+	}
+	remaining_--;
+	return static_cast<unsigned int>(v);
+}
+
+bool
+DecisionTrace::write(void)
+{
+	vector<unsigned char> head(trace_magic, trace_magic + trace_magic_len);
+	put_varint(head, trace_version);
+	put_varint(head, seed_);
+	put_varint(head, count_);
+
+	ofstream out(file_.c_str(), ios_base::out | ios_base::binary | ios_base::trunc);
+	out.write(reinterpret_cast<const char *>(&head[0]), head.size());
+	if (!buf_.empty())
+		out.write(reinterpret_cast<const char *>(&buf_[0]), buf_.size());
+	out.close();
+	return !out.fail();
+}
+
+/*
+ * Write the trace being recorded, and forget the trace.
+ */
+void
+DecisionTrace::doFinalization(void)
+{
+	if (!instance_)
+		return;
+	if (!instance_->replaying_ && !instance_->write()) {
+		cerr << "error: can't write " << instance_->file_ << std::endl;
+	}
+	if (instance_->replaying_ && instance_->remaining_ > 0) {
+		cerr << "warning: " << instance_->remaining_ << " decisions of " << instance_->file_
+			 << " were not used, the options may differ from the recording" << std::endl;
+	}
+	delete instance_;
+	instance_ = NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,119 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DECISION_TRACE_H
+#define DECISION_TRACE_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+#include "Common.h"
+
+/*
+ * The random decisions of one program, for --record-trace and --replay-trace.
+ *
+ * The file starts with the magic "CSMTRACE", followed by the format version,
+ * the seed and the number of decisions, then one number per decision. All
+ * numbers are unsigned LEB128 varints, so most decisions take one byte.
+ * A decision is the value returned by rnd_upto or rnd_flipcoin after
+ * filtering, or one digit of a random constant.
+ *
+ * Replaying needs the same options as recording. The trace is mapped into
+ * memory where mmap is available and read sequentially.
+ */
+class DecisionTrace
+{
+public:
+	static DecisionTrace *CreateRecorder(const std::string &file, unsigned long seed);
+
+	static DecisionTrace *OpenReplay(const std::string &file, std::string &err);
+
+	static DecisionTrace *GetInstance(void) { return instance_; }
+
+	static void doFinalization(void);
+
+	bool replaying(void) const { return replaying_; }
+
+	unsigned long seed(void) const { return seed_; }
+
+	void record(unsigned int v);
+
+	unsigned int next(unsigned int bound);
+
+private:
+	DecisionTrace(const std::string &file, bool replaying, unsigned long seed);
+
+	~DecisionTrace(void);
+
+	bool write(void);
+
+	bool map_file(std::string &err);
+
+	static void put_varint(std::vector<unsigned char> &buf, unsigned INT64 v);
+
+	bool get_varint(unsigned INT64 &v);
+
+	static DecisionTrace *instance_;
+
+	const std::string file_;
+
+	const bool replaying_;
+
+	unsigned long seed_;
+
+	// recording
+	std::vector<unsigned char> buf_;
+
+	unsigned INT64 count_;
+
+	// replaying: [cur_, end_) is what is left of the mapped file
+	const unsigned char *data_;
+
+	size_t size_;
+
+	bool mapped_;
+
+	const unsigned char *cur_;
+
+	const unsigned char *end_;
+
+	unsigned INT64 remaining_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // DECISION_TRACE_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
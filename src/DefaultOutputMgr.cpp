@@ -35,6 +35,8 @@
 
 #include <cassert>
 #include <sstream>
+#include <algorithm>
+#include <thread>
 #include "Common.h"
 #include "CGOptions.h"
 #include "platform.h"
@@ -46,6 +48,8 @@
 #include "Type.h"
 #include "random.h"
 #include "Error.h"
+#include "Profiler.h"
+#include "OutputBuffer.h"
 
 static std::string filename_prefix = "rnd_output";
 
@@ -59,7 +63,9 @@ static std::string dir_sep = "\\";
 
 using namespace std;
 
-DefaultOutputMgr *DefaultOutputMgr::instance_ = NULL;
+thread_local DefaultOutputMgr *DefaultOutputMgr::instance_ = NULL;
+
+thread_local std::ostream *DefaultOutputMgr::main_out_ = NULL;
 
 DefaultOutputMgr *
 DefaultOutputMgr::CreateInstance()
@@ -81,12 +87,19 @@ DefaultOutputMgr::CreateInstance()
 	return DefaultOutputMgr::instance_;
 }
 
+std::string
+DefaultOutputMgr::split_file_name(int num, const std::string &ext)
+{
+	std::ostringstream ss;
+	ss << filename_prefix << num << ext;
+	return ss.str();
+}
+
 ofstream *
 DefaultOutputMgr::open_one_output_file(int num)
 {
-	std::ostringstream ss;
-	ss << CGOptions::split_files_dir() << dir_sep << filename_prefix << num << ".c";
-	ofstream *ofile = new ofstream(ss.str().c_str());
+	std::string name = CGOptions::split_files_dir() + dir_sep + split_file_name(num, ".c");
+	ofstream *ofile = new ofstream(name.c_str());
 	return ofile;
 }
 
@@ -95,12 +108,19 @@ DefaultOutputMgr::init()
 {
 	int max_files = CGOptions::max_split_files();
 
-	if (max_files == 0)
+	if (max_files == 0) {
+		if (!main_out_) {
+			buffer_ = new OutputBuffer(ofile_ ? *ofile_ : std::cout);
+			buffered_out_ = new std::ostream(buffer_);
+		}
 		return;
+	}
 
 	for (int i = 0; i < max_files; ++i) {
-		ofstream *out = open_one_output_file(i);
-		outs.push_back(out);
+		if (CGOptions::balance_split_files())
+			outs.push_back(new ostringstream());
+		else
+			outs.push_back(open_one_output_file(i));
 	}
 }
 
@@ -110,6 +130,16 @@ DefaultOutputMgr::create_output_dir(std::string dir)
 	return create_dir(dir.c_str());
 }
 
+/*
+ * Send the programs of this thread to <out> instead of stdout, when no
+ * output file is given. Used by batch mode to collect each program.
+ */
+void
+DefaultOutputMgr::set_main_out(std::ostream *out)
+{
+	main_out_ = out;
+}
+
 void
 DefaultOutputMgr::OutputGlobals()
 {
@@ -117,15 +147,17 @@ DefaultOutputMgr::OutputGlobals()
 	ss << CGOptions::split_files_dir() << dir_sep << global_header << ".h";
 
 	ofstream ofile(ss.str().c_str());
-	ofile << "#ifndef RND_GLOBALS_H" << std::endl;
-	ofile << "#define RND_GLOBALS_H" << std::endl;
-	ofile << "#include \"safe_math.h\"" << std::endl;
+	ofile << "#ifndef RND_GLOBALS_H" << '\n';
+	ofile << "#define RND_GLOBALS_H" << '\n';
+	// safe_math.h needs the macros of csmith.h
+	ofile << "#include \"csmith.h\"" << '\n';
+
+	// the global variables may be of these types
+	OutputStructUnionDeclarations(ofile);
 
 	string prefix = "extern ";
 	OutputGlobalVariablesDecls(ofile, prefix);
-
-	OutputStructUnionDeclarations(ofile);
-	ofile << "#endif" << std::endl;
+	ofile << "#endif" << '\n';
 	ofile.close();
 }
 
@@ -133,26 +165,26 @@ void
 DefaultOutputMgr::OutputAllHeaders()
 {
 	for (unsigned i = 1; i < outs.size(); ++i) {
-		ofstream *out = outs[i];
-		*out << "#include <stdint.h>" << std::endl;
+		ostream *out = outs[i];
+		*out << "#include <stdint.h>" << '\n';
 
 		if (CGOptions::paranoid())
-			*out << "#include <assert.h>" << std::endl;
+			*out << "#include <assert.h>" << '\n';
 
-		*out << "#include <limits.h>" << std::endl;
-		*out << "#include \"" << global_header << ".h\"" << std::endl;
-		*out << std::endl;
+		*out << "#include <limits.h>" << '\n';
+		*out << "#include \"" << global_header << ".h\"" << '\n';
+		*out << '\n';
 	}
 
-	*outs[0] << "#include \"" << global_header << ".h\"" << std::endl;
+	*outs[0] << "#include \"" << global_header << ".h\"" << '\n';
 
-	vector<ofstream *>::iterator j;
+	vector<ostream *>::iterator j;
 	for (j = outs.begin(); j != outs.end(); ++j) {
-		ofstream *out = (*j);
+		ostream *out = (*j);
 		string prefix = "extern ";
 		// OutputGlobalVariablesDecls(*out, prefix);
 		OutputForwardDeclarations(*out);
-		*out << std::endl;
+		*out << '\n';
 	}
 }
 
@@ -190,6 +222,113 @@ DefaultOutputMgr::RandomOutputDefs()
 	RandomOutputFuncDefs();
 }
 
+/*
+ * With --balance-split-files the definitions are rendered in the usual
+ * order and handed out to the files only once main is complete.
+ */
+void
+DefaultOutputMgr::RenderDefs()
+{
+	vector<Variable*> *globals = VariableSelector::GetGlobalVariables();
+	vector<Variable*>::iterator i;
+	for (i = globals->begin(); i != globals->end(); ++i) {
+		ostringstream ss;
+		(*i)->OutputDef(ss, 0);
+		defs_.push_back(ss.str());
+	}
+	const vector<Function*> &funcs = get_all_functions();
+	vector<Function*>::const_iterator j;
+	for (j = funcs.begin(); j != funcs.end(); ++j) {
+		if ((*j)->is_builtin)
+			continue;
+		ostringstream ss;
+		(*j)->Output(ss);
+		defs_.push_back(ss.str());
+	}
+	defs_pos_ = outs[0]->tellp();
+}
+
+/*
+ * Give every file about the same amount of code, the largest definition
+ * first to the file with the least text so far, keeping the original
+ * order within each file. Then write the files, one thread each.
+ */
+void
+DefaultOutputMgr::WriteSplitFiles()
+{
+	vector<size_t> order(defs_.size());
+	for (size_t k = 0; k < order.size(); k++)
+		order[k] = k;
+	stable_sort(order.begin(), order.end(),
+		[this](size_t a, size_t b) { return defs_[a].size() > defs_[b].size(); });
+
+	// the headers, and main in the first file, count too
+	vector<size_t> sizes;
+	for (size_t k = 0; k < outs.size(); k++)
+		sizes.push_back(outs[k]->tellp());
+	vector<size_t> file_of(defs_.size());
+	for (size_t k = 0; k < order.size(); k++) {
+		size_t smallest = min_element(sizes.begin(), sizes.end()) - sizes.begin();
+		file_of[order[k]] = smallest;
+		sizes[smallest] += defs_[order[k]].size();
+	}
+
+	vector<string> texts(outs.size());
+	for (size_t k = 0; k < outs.size(); k++) {
+		texts[k] = static_cast<ostringstream*>(outs[k])->str();
+		texts[k].reserve(sizes[k]);
+	}
+	string main_text = texts[0].substr(defs_pos_);
+	texts[0].resize(defs_pos_);
+	for (size_t k = 0; k < defs_.size(); k++)
+		texts[file_of[k]] += defs_[k];
+	texts[0] += main_text;
+
+	vector<std::thread> writers;
+	for (size_t k = 0; k < texts.size(); k++) {
+		const string *text = &texts[k];
+		writers.push_back(std::thread([this, k, text]() {
+			ofstream *ofile = open_one_output_file(k);
+			*ofile << *text;
+			delete ofile;
+		}));
+	}
+	for (size_t k = 0; k < writers.size(); k++)
+		writers[k].join();
+	OutputMakefile();
+}
+
+/*
+ * A Makefile next to the split files, so that `make -j' compiles them in
+ * parallel. The csmith runtime headers come from CPPFLAGS.
+ */
+void
+DefaultOutputMgr::OutputMakefile()
+{
+	string name = CGOptions::split_files_dir() + dir_sep + "Makefile";
+	ofstream ofile(name.c_str());
+	ofile << "# Builds the split program, e.g. make -j8 CPPFLAGS=-I<csmith runtime dir>" << '\n';
+	ofile << "CC = cc" << '\n';
+	ofile << "CFLAGS = -O2" << '\n';
+	ofile << "PROGRAM = " << filename_prefix << '\n';
+	ofile << "OBJS =";
+	for (size_t k = 0; k < outs.size(); k++)
+		ofile << " " << split_file_name(k, ".o");
+	ofile << '\n' << '\n';
+	ofile << "all: $(PROGRAM)" << '\n' << '\n';
+	ofile << "$(PROGRAM): $(OBJS)" << '\n';
+	ofile << "\t$(CC) $(CFLAGS) $(LDFLAGS) -o $@ $(OBJS)" << '\n' << '\n';
+	for (size_t k = 0; k < outs.size(); k++) {
+		ofile << split_file_name(k, ".o") << ": " << split_file_name(k, ".c")
+			<< " " << global_header << ".h" << '\n';
+		ofile << "\t$(CC) $(CPPFLAGS) $(CFLAGS) -c -o $@ " << split_file_name(k, ".c") << '\n' << '\n';
+	}
+	ofile << "clean:" << '\n';
+	ofile << "\trm -f $(PROGRAM) $(OBJS)" << '\n' << '\n';
+	ofile << ".PHONY: all clean" << '\n';
+	ofile.close();
+}
+
 void
 DefaultOutputMgr::OutputHeader(int argc, char *argv[], unsigned long seed)
 {
@@ -203,7 +342,14 @@ DefaultOutputMgr::Output()
 	if (is_split()) {
 		OutputGlobals();
 		OutputAllHeaders();
-		RandomOutputDefs();
+		if (CGOptions::balance_split_files())
+			RenderDefs();
+		else
+			RandomOutputDefs();
+	}
+	else if (CGOptions::stream_output()) {
+		// the functions are out already
+		OutputNewDeclarations(out);
 	}
 	else {
 		OutputStructUnionDeclarations(out);
@@ -219,6 +365,58 @@ DefaultOutputMgr::Output()
 	if (!CGOptions::nomain())
 		OutputMain(out);
 	OutputTail(out);
+	if (buffer_)
+		buffer_->write_out();
+	if (is_split() && CGOptions::balance_split_files())
+		WriteSplitFiles();
+}
+
+/*
+ * With --stream-output the program is written while it is generated: the
+ * types used so far first, then each function as soon as it is complete,
+ * preceded by the struct/union types, global variables and forward
+ * declarations created since the last one.
+ * A function never refers to anything created after it is complete.
+ */
+void
+DefaultOutputMgr::OutputTypes()
+{
+	ProfileScope scope(Profiler::pOutput);
+	OutputStructUnionDeclarations(get_main_out());
+}
+
+void
+DefaultOutputMgr::OutputFinishedFunction(Function *f)
+{
+	ProfileScope scope(Profiler::pOutput);
+	std::ostream &out = get_main_out();
+	OutputNewDeclarations(out);
+	f->Output(out);
+	// the point of streaming is to let the function go now
+	if (buffer_)
+		buffer_->write_out();
+}
+
+void
+DefaultOutputMgr::OutputNewDeclarations(std::ostream &out)
+{
+	// types picked for the first time by this function
+	OutputNewStructUnions(out);
+	const vector<Variable*> &globals = *VariableSelector::GetGlobalVariables();
+	if (globals_done_ < globals.size()) {
+		vector<Variable*> vars(globals.begin() + globals_done_, globals.end());
+		outputln(out);
+		OutputVariableList(vars, out);
+		globals_done_ = globals.size();
+	}
+	const vector<Function*> &funcs = get_all_functions();
+	if (funcs_declared_ < funcs.size()) {
+		outputln(out);
+		for (; funcs_declared_ < funcs.size(); funcs_declared_++) {
+			funcs[funcs_declared_]->OutputForwardDecl(out);
+		}
+		outputln(out);
+	}
 }
 
 std::ostream &
@@ -226,9 +424,15 @@ DefaultOutputMgr::get_main_out()
 {
 	if (is_split())
 		return *(outs[0]);
+	else if (buffered_out_) {
+		return *buffered_out_;
+	}
 	else if (ofile_) {
 		return *ofile_;
 	}
+	else if (main_out_) {
+		return *main_out_;
+	}
 	else {
 		return std::cout;
 	}
@@ -243,7 +447,7 @@ DefaultOutputMgr::is_split()
 void
 DefaultOutputMgr::outputln(ostream &out)
 {
-	out << std::endl;
+	out << '\n';
 }
 
 void
@@ -260,27 +464,42 @@ DefaultOutputMgr::output_tab(ostream &out, int indent)
 
 //////////////////////////////////////////////////////////////////
 DefaultOutputMgr::DefaultOutputMgr(std::ofstream *ofile)
-	: ofile_(ofile)
+	: ofile_(ofile),
+	  buffer_(NULL),
+	  buffered_out_(NULL),
+	  defs_pos_(0),
+	  globals_done_(0),
+	  funcs_declared_(0)
 {
 
 }
 
 DefaultOutputMgr::DefaultOutputMgr()
-	: ofile_(NULL)
+	: ofile_(NULL),
+	  buffer_(NULL),
+	  buffered_out_(NULL),
+	  defs_pos_(0),
+	  globals_done_(0),
+	  funcs_declared_(0)
 {
 
 }
 
 DefaultOutputMgr::~DefaultOutputMgr()
 {
-	std::vector<std::ofstream *>::iterator out;
+	std::vector<std::ostream *>::iterator out;
 	for (out = outs.begin(); out != outs.end(); ++out) {
-		(*out)->close();
+		// an ofstream closes itself
 		delete (*out);
 	}
 	outs.clear();
+	// whatever is left goes out before the file is closed
+	delete buffered_out_;
+	delete buffer_;
 	if (ofile_)
 		ofile_->close();
 	delete ofile_;
+	if (instance_ == this)
+		instance_ = NULL;
 }
 
@@ -38,6 +38,8 @@
 
 using namespace std;
 
+class OutputBuffer;
+
 class DefaultOutputMgr : public OutputMgr {
 public:
 	static DefaultOutputMgr *CreateInstance();
@@ -46,10 +48,16 @@ public:
 
 	static bool create_output_dir(std::string dir);
 
+	static void set_main_out(std::ostream *out);
+
 	virtual void OutputHeader(int argc, char *argv[], unsigned long seed);
 
 	virtual void Output();
 
+	virtual void OutputTypes();
+
+	virtual void OutputFinishedFunction(Function *f);
+
 	virtual void outputln(ostream &out);
 
 	virtual void output_comment_line(ostream &out, const std::string &comment);
@@ -65,6 +73,8 @@ private:
 
 	bool is_split();
 
+	static std::string split_file_name(int num, const std::string &ext);
+
 	std::ofstream* open_one_output_file(int num);
 
 	void init();
@@ -79,11 +89,39 @@ private:
 
 	void RandomOutputFuncDefs();
 
-	static DefaultOutputMgr *instance_;
+	void RenderDefs();
+
+	void WriteSplitFiles();
+
+	void OutputMakefile();
+
+	void OutputNewDeclarations(std::ostream &out);
 
-	std::vector<std::ofstream* > outs;
+	static thread_local DefaultOutputMgr *instance_;
+
+	// where the program goes without an output file, stdout if NULL
+	static thread_local std::ostream *main_out_;
+
+	// the split files, kept in memory with --balance-split-files
+	std::vector<std::ostream* > outs;
 
 	std::ofstream *ofile_;
+
+	// the program text on its way to ofile_ or stdout, written out at once
+	OutputBuffer *buffer_;
+
+	std::ostream *buffered_out_;
+
+	// the rendered definitions for --balance-split-files, and where they
+	// go in the first file, before main
+	std::vector<std::string> defs_;
+
+	size_t defs_pos_;
+
+	// what --stream-output has written so far
+	size_t globals_done_;
+
+	size_t funcs_declared_;
 };
 
 #endif // DEFAULT_OUTPUT_MGR_H
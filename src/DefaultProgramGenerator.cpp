@@ -43,6 +43,9 @@
 #include "CGOptions.h"
 #include "SafeOpFlags.h"
 #include "ExtensionMgr.h"
+#include "Profiler.h"
+#include "Budget.h"
+#include "TargetSize.h"
 
 DefaultProgramGenerator::DefaultProgramGenerator(int argc, char *argv[], unsigned long seed)
 	: argc_(argc),
@@ -79,11 +82,22 @@ DefaultProgramGenerator::get_count_prefix(const std::string &)
 void
 DefaultProgramGenerator::goGenerator()
 {
+	Profiler::start();
+	Budget::start();
+	TargetSize::start();
 	output_mgr_->OutputHeader(argc_, argv_, seed_);
 
-	GenerateAllTypes();
+	{
+		ProfileScope scope(Profiler::pTypes);
+		GenerateAllTypes();
+	}
+	if (CGOptions::stream_output())
+		output_mgr_->OutputTypes();
 	GenerateFunctions();
-	output_mgr_->Output();
+	{
+		ProfileScope scope(Profiler::pOutput);
+		output_mgr_->Output();
+	}
 	if (CGOptions::identify_wrappers()) {
 		ofstream ofile;
 		ofile.open("wrapper.h");
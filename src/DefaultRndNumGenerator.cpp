@@ -43,8 +43,9 @@
 #include "SequenceFactory.h"
 #include "Sequence.h"
 #include "CGOptions.h"
+#include "DecisionTrace.h"
 
-DefaultRndNumGenerator *DefaultRndNumGenerator::impl_ = 0;
+thread_local DefaultRndNumGenerator *DefaultRndNumGenerator::impl_ = 0;
 
 /*
  *
@@ -52,7 +53,8 @@ DefaultRndNumGenerator *DefaultRndNumGenerator::impl_ = 0;
 DefaultRndNumGenerator::DefaultRndNumGenerator(const unsigned long, Sequence *concrete_seq)
 	: rand_depth_(0),
 	  trace_string_(""),
-	  seq_(concrete_seq)
+	  seq_(concrete_seq),
+	  trace_(DecisionTrace::GetInstance())
 {
 	//Nothing to do
 }
@@ -63,6 +65,8 @@ DefaultRndNumGenerator::DefaultRndNumGenerator(const unsigned long, Sequence *co
 DefaultRndNumGenerator::~DefaultRndNumGenerator()
 {
 	SequenceFactory::destroy_sequences();
+	if (impl_ == this)
+		impl_ = 0;
 }
 
 /*
@@ -115,13 +119,18 @@ DefaultRndNumGenerator::rnd_upto(const unsigned int n, const Filter *f, const st
 	int h = g;
 	if (h == 440)
 		BREAK_NOP;   // for debugging
+	if (trace_ && trace_->replaying())
+		return replay_upto(n, f, where);
 	unsigned int v = genrand() % n;
 	unsigned INT64 local_depth = rand_depth_;
 	rand_depth_++;
 	//ofstream out("rnd.log", ios_base::app);
 	//out << g++ << ": " << v << "(" << n << ")" << endl;
 
-	if (f) {
+	if (f && CGOptions::direct_sampling()) {
+		v = draw_admissible(v, n, f, local_depth);
+	}
+	else if (f) {
 		while (f->filter(v)) {
 			// We could add numbers into sequence inside the previous filter.
 			// If the previous filter failed, we need to roll back the rand_depth_ here.
@@ -132,6 +141,8 @@ DefaultRndNumGenerator::rnd_upto(const unsigned int n, const Filter *f, const st
 		}
 	}
 	//out.close();
+	if (trace_)
+		trace_->record(v);
 	if (where) {
 	std::ostringstream ss;
 		ss << *where << "->";
@@ -141,6 +152,58 @@ DefaultRndNumGenerator::rnd_upto(const unsigned int n, const Filter *f, const st
 	return v;
 }
 
+/*
+ * For --direct-sampling: instead of drawing again until a value passes the
+ * filter, draw once more from the values that pass. If the first draw v is
+ * rejected, the second one is uniform over the k admissible values, so every
+ * admissible value still has the probability 1/k.
+ */
+unsigned int
+DefaultRndNumGenerator::draw_admissible(unsigned int v, const unsigned int n, const Filter *f, unsigned INT64 local_depth)
+{
+	if (!f->filter(v))
+		return v;
+
+	std::vector<unsigned int> values;
+	if (!f->admissible(n, values)) {
+		// fall back to drawing until a value passes
+		do {
+			rand_depth_ = local_depth+1;
+			v = genrand() % n;
+		} while (f->filter(v));
+		return v;
+	}
+	assert(!values.empty());
+	rand_depth_ = local_depth+1;
+	v = values[genrand() % values.size()];
+	// let the filter see the value chosen, some remember it
+	bool rejected = f->filter(v);
+	assert(!rejected);
+	(void)rejected;
+	return v;
+}
+
+/*
+ * For --replay-trace: take the value of rnd_upto from the trace. The filter
+ * only sees the value finally chosen when recording, which it must accept.
+ */
+unsigned int
+DefaultRndNumGenerator::replay_upto(const unsigned int n, const Filter *f, const std::string *where)
+{
+	unsigned INT64 local_depth = rand_depth_;
+	rand_depth_++;
+	unsigned int v = trace_->next(n);
+	if (f && f->filter(v)) {
+		// not what was recorded, let next() report it
+		trace_->next(0);
+	}
+	if (where) {
+		trace_string_ += *where + "->";
+	}
+	add_number(v, n, local_depth);
+	return v;
+}
+
 /*
  * Return `true' p% of the time.
  */
@@ -161,7 +224,15 @@ DefaultRndNumGenerator::rnd_flipcoin(const unsigned int p, const Filter *f, cons
 		}
 	}
 
-	bool rv = (genrand() % 100) < p;
+	bool rv;
+	if (trace_ && trace_->replaying()) {
+		rv = trace_->next(2);
+	}
+	else {
+		rv = (genrand() % 100) < p;
+		if (trace_)
+			trace_->record(rv);
+	}
 	if (rv) {
 		add_number(1, 2, local_depth);
 	}
@@ -192,7 +263,15 @@ DefaultRndNumGenerator::RandomHexDigits( int num )
 	std::string str;
 	const char* hex1 = AbsRndNumGenerator::get_hex1();
 	while (num--) {
-		int x = genrand() % 16;
+		int x;
+		if (trace_ && trace_->replaying()) {
+			x = trace_->next(16);
+		}
+		else {
+			x = genrand() % 16;
+			if (trace_)
+				trace_->record(x);
+		}
 		str += hex1[x];
 		seq_->add_number(x, 16, rand_depth_);
 		rand_depth_++;
@@ -209,7 +288,15 @@ DefaultRndNumGenerator::RandomDigits( int num )
 	std::string str;
 	const char* dec1 = AbsRndNumGenerator::get_dec1();
 	while (num--) {
-		int x = genrand() % 10;
+		int x;
+		if (trace_ && trace_->replaying()) {
+			x = trace_->next(10);
+		}
+		else {
+			x = genrand() % 10;
+			if (trace_)
+				trace_->record(x);
+		}
 		str += dec1[x];
 		seq_->add_number(x, 10, rand_depth_);
 		rand_depth_++;
@@ -38,6 +38,7 @@
 
 class Sequence;
 class Filter;
+class DecisionTrace;
 
 // Singleton class for the implementation of default based random generator
 class DefaultRndNumGenerator : public AbsRndNumGenerator
@@ -70,7 +71,11 @@ private:
 
 	void add_number(int v, int bound, int k);
 
-	static DefaultRndNumGenerator *impl_;
+	unsigned int draw_admissible(unsigned int v, const unsigned int n, const Filter *f, unsigned INT64 local_depth);
+
+	unsigned int replay_upto(const unsigned int n, const Filter *f, const std::string *where);
+
+	static thread_local DefaultRndNumGenerator *impl_;
 
 	unsigned INT64 rand_depth_;
 
@@ -78,6 +83,9 @@ private:
 
 	Sequence *seq_;
 
+	// --record-trace or --replay-trace, NULL otherwise
+	DecisionTrace *trace_;
+
 	virtual unsigned long genrand(void);
 
 	//void seedrand(unsigned long seed);
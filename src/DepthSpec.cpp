@@ -45,6 +45,7 @@
 #include "SafeOpFlags.h"
 #include "VariableSelector.h"
 #include "Expression.h"
+#include "Profiler.h"
 
 using namespace std;
 
@@ -365,9 +366,12 @@ DepthSpec::dtSafeOpFlags_minimal_depth(int flag)
 int
 DepthSpec::backtracking(int depth_needed)
 {
+	ProfileScope scope(Profiler::pBacktracking);
 	DFSRndNumGenerator *impl = dynamic_cast<DFSRndNumGenerator*>(RandomNumber::GetRndNumGenerator());
-	if(impl->eager_backtracking(depth_needed))
+	if(impl->eager_backtracking(depth_needed)) {
+		Profiler::count_backtrack();
 		return BAD_DEPTH;
+	}
 	else
 		return GOOD_DEPTH;
 }
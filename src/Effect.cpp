@@ -52,26 +52,16 @@ const Effect Effect::empty_effect;
 ///////////////////////////////////////////////////////////////////////////////
 
 /*
- * Stuff that so badly wants to be rewritten using decent STL containers and
- * algorithms.
+ * index a variable in a read or write set: itself in <bits>, itself and all
+ * the struct/unions containing it in <match_bits>
  */
-static bool
-non_empty_intersection(const vector<const Variable *> &va,
-					   const vector<const Variable *> &vb)
+static void
+add_var_bits(BitSet &bits, BitSet &match_bits, const Variable *v)
 {
-	vector<const Variable *>::size_type va_len = va.size();
-	vector<const Variable *>::size_type vb_len = vb.size();
-	vector<const Variable *>::size_type i;
-	vector<const Variable *>::size_type j;
-
-	for (i = 0; i < va_len; ++i) {
-		for (j = 0; j < vb_len; ++j) {
-			if (va[i]->match(vb[j]) || vb[j]->match(va[i])) {
-				return true;
-			}
-		}
+	bits.set(v->id);
+	for (; v; v = v->field_var_of) {
+		match_bits.set(v->id);
 	}
-	return false;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -94,6 +84,10 @@ Effect::Effect(void) :
 Effect::Effect(const Effect &e) :
 	read_vars(e.read_vars),
 	write_vars(e.write_vars),
+	read_bits(e.read_bits),
+	write_bits(e.write_bits),
+	read_match_bits(e.read_match_bits),
+	write_match_bits(e.write_match_bits),
 	pure(e.pure),
 	side_effect_free(e.side_effect_free)
 {
@@ -120,12 +114,26 @@ Effect::operator=(const Effect &e)
 
 	read_vars = e.read_vars;
 	write_vars = e.write_vars;
+	read_bits = e.read_bits;
+	write_bits = e.write_bits;
+	read_match_bits = e.read_match_bits;
+	write_match_bits = e.write_match_bits;
 	pure = e.pure;
 	side_effect_free = e.side_effect_free;
 
 	return *this;
 }
 
+/*
+ * the bit sets are derived from the variables, so they need no comparing
+ */
+bool
+Effect::operator==(const Effect &e) const
+{
+	return read_vars == e.read_vars && write_vars == e.write_vars &&
+		pure == e.pure && side_effect_free == e.side_effect_free;
+}
+
 /*
  *
  */
@@ -134,6 +142,7 @@ Effect::read_var(const Variable *v)
 {
 	if (!is_read(v)) {
 		read_vars.push_back(v);
+		add_var_bits(read_bits, read_match_bits, v);
 	}
 	pure &= (v->is_const() && !v->is_volatile() && !v->is_access_once());
 	side_effect_free &= (!v->is_volatile() && !v->is_access_once());
@@ -159,6 +168,7 @@ Effect::write_var(const Variable *v)
 {
 	if (!is_written(v)) {
 		write_vars.push_back(v);
+		add_var_bits(write_bits, write_match_bits, v);
 	}
 	// pure = pure;
 	// TODO: not quite correct below ---
@@ -185,8 +195,8 @@ Effect::add_effect(const Effect &e, bool include_lhs_effects)
 		return;
 	}
 
-	// Stuff that so badly wants to be rewritten using decent STL containers
-	// and algorithms... compute the union effect.
+	// compute the union effect. the order of the variables is kept, and a
+	// field is not added if its struct is already in the set
 
 	vector<const Variable *>::size_type len;
 	vector<const Variable *>::size_type i;
@@ -194,15 +204,19 @@ Effect::add_effect(const Effect &e, bool include_lhs_effects)
 	len = e.read_vars.size();
 	for (i = 0; i < len; ++i) {
 		// this->read_var(e.read_vars[i]);
-		if (!is_read(e.read_vars[i])) {
-			this->read_vars.push_back(e.read_vars[i]);
+		const Variable* v = e.read_vars[i];
+		if (!is_read(v)) {
+			this->read_vars.push_back(v);
+			add_var_bits(read_bits, read_match_bits, v);
 		}
 	}
 	len = e.write_vars.size();
 	for (i = 0; i < len; ++i) {
 		// this->write_var(e.write_vars[i]);
-		if (!is_written(e.write_vars[i])) {
-			this->write_vars.push_back(e.write_vars[i]);
+		const Variable* v = e.write_vars[i];
+		if (!is_written(v)) {
+			this->write_vars.push_back(v);
+			add_var_bits(write_bits, write_match_bits, v);
 		}
 	}
 
@@ -308,7 +322,7 @@ Effect::add_external_effect(const Effect &e, std::vector<const Block*> call_chai
 bool
 Effect::is_read(const Variable *v) const
 {
-	if (std::find(read_vars.begin(), read_vars.end(), v) != read_vars.end()) {
+	if (read_bits.test(v->id)) {
 		return true;
 	}
 
@@ -370,13 +384,8 @@ Effect::is_read(string vname) const
 bool
 Effect::is_written(const Variable *v) const
 {
-	vector<Variable *>::size_type len = write_vars.size();
-	vector<Variable *>::size_type i;
-
-	for (i = 0; i < len; ++i) {
-		if (write_vars[i] == v) {
-			return true;
-		}
+	if (write_bits.test(v->id)) {
+		return true;
 	}
 	// if we write a struct/union, presumingly all the fields are written too
 	if (v->field_var_of) {
@@ -492,16 +501,20 @@ Effect::sibling_union_field_is_written(const Variable *v) const
 	return false;
 }
 
+/*
+ * v is in the match set iff v or one of its fields is read, so with is_read,
+ * it covers field_is_read without walking the fields
+ */
 bool
 Effect::is_read_partially(const Variable* v) const
 {
-	return is_read(v) || field_is_read(v) || sibling_union_field_is_read(v);
+	return is_read(v) || read_match_bits.test(v->id) || sibling_union_field_is_read(v);
 }
 
 bool
 Effect::is_written_partially(const Variable* v) const
 {
-	return is_written(v) || field_is_written(v) || sibling_union_field_is_written(v);
+	return is_written(v) || write_match_bits.test(v->id) || sibling_union_field_is_written(v);
 }
 
 /*
@@ -516,6 +529,7 @@ Effect::consolidate(void)
 		const Variable* tmp = read_vars[i];
 		if (tmp->is_field_var() && is_read(tmp->field_var_of)) {
 			read_vars.erase(read_vars.begin() + i);
+			read_bits.reset(tmp->id);
 			i--;
 			len--;
 		}
@@ -525,21 +539,43 @@ Effect::consolidate(void)
 		const Variable* tmp = write_vars[i];
 		if (tmp->is_field_var() && is_written(tmp->field_var_of)) {
 			write_vars.erase(write_vars.begin() + i);
+			write_bits.reset(tmp->id);
 			i--;
 			len--;
 		}
 	}
+	index_vars();
 }
 
 /*
- *
+ * rebuild the bit sets from the read/write sets
+ */
+void
+Effect::index_vars(void)
+{
+	size_t i;
+	read_bits.clear();
+	read_match_bits.clear();
+	for (i=0; i<read_vars.size(); i++) {
+		add_var_bits(read_bits, read_match_bits, read_vars[i]);
+	}
+	write_bits.clear();
+	write_match_bits.clear();
+	for (i=0; i<write_vars.size(); i++) {
+		add_var_bits(write_bits, write_match_bits, write_vars[i]);
+	}
+}
+
+/*
+ * two variables race if they are the same, or one is a struct/union containing
+ * the other (see Variable::match)
  */
 bool
 Effect::has_race_with(const Effect &e) const
 {
-	return (non_empty_intersection(this->read_vars,  e.write_vars)
-			|| non_empty_intersection(this->write_vars, e.read_vars)
-			|| non_empty_intersection(this->write_vars, e.write_vars));
+	return (read_bits.intersects(e.write_match_bits) || read_match_bits.intersects(e.write_bits)
+			|| write_bits.intersects(e.read_match_bits) || write_match_bits.intersects(e.read_bits)
+			|| write_bits.intersects(e.write_match_bits) || write_match_bits.intersects(e.write_bits));
 }
 
 /*
@@ -559,6 +595,10 @@ Effect::clear(void)
 {
 	read_vars.clear();
 	write_vars.clear();
+	read_bits.clear();
+	write_bits.clear();
+	read_match_bits.clear();
+	write_match_bits.clear();
 	pure = side_effect_free = true;
 }
 
@@ -575,7 +615,7 @@ Effect::Output(std::ostream &out) const
 
 	std::ostringstream ss;
 
-	ss << std::endl;
+	ss << '\n';
 	ss << " * reads :";
 	len = read_vars.size();
 	for (i = 0; i < len; ++i) {
@@ -583,7 +623,7 @@ Effect::Output(std::ostream &out) const
 		read_vars[i]->OutputForComment(ss);
 
 	}
-	ss << endl;
+	ss << '\n';
 
 	ss << " * writes:";
 	len = write_vars.size();
@@ -591,7 +631,7 @@ Effect::Output(std::ostream &out) const
 		ss << " ";
 		write_vars[i]->OutputForComment(ss);
 	}
-	ss << endl;
+	ss << '\n';
 
 	output_comment_line(out, ss.str());
 }
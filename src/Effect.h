@@ -34,6 +34,7 @@
 
 #include <ostream>
 #include <vector>
+#include "BitSet.h"
 
 class Variable;
 class Block;
@@ -50,6 +51,9 @@ public:
 
 	Effect &operator=(const Effect &e);
 
+	// same as what operator= copies
+	bool operator==(const Effect &e) const;
+
 	void read_var(const Variable *v);
 	void access_deref_volatile(const Variable *v, int deref_level);
 	void write_var(const Variable *v);
@@ -93,10 +97,21 @@ public:
 	void update_purity(void);
 
 private:
+	void index_vars(void);
+
 	std::vector<const Variable *> read_vars;
 	std::vector<const Variable *> write_vars;
 	std::vector<const Variable *> lhs_write_vars;
 
+	// the same read/write sets indexed by Variable::id. the "match" sets also
+	// have the containers of every member, i.e. all the variables v such that
+	// v->match(member) holds. together they answer has_race_with with a few
+	// word operations instead of comparing every pair of variables
+	BitSet read_bits;
+	BitSet write_bits;
+	BitSet read_match_bits;
+	BitSet write_match_bits;
+
 	bool pure;
 	bool side_effect_free;
 
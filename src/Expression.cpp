@@ -62,14 +62,15 @@
 #include "CVQualifiers.h"
 #include "DepthSpec.h"
 
-int eid = 0;
+thread_local int eid = 0;
 
-DistributionTable Expression::exprTable_;
-DistributionTable Expression::paramTable_;
+thread_local DistributionTable Expression::exprTable_;
+thread_local DistributionTable Expression::paramTable_;
 
 void
 Expression::InitExprProbabilityTable()
 {
+	exprTable_.clear();
 	exprTable_.add_entry((int)eFunction, 70);
 	exprTable_.add_entry((int)eVariable, 20);
 	exprTable_.add_entry((int)eConstant, 10);
@@ -84,6 +85,7 @@ Expression::InitExprProbabilityTable()
 void
 Expression::InitParamProbabilityTable()
 {
+	paramTable_.clear();
 	paramTable_.add_entry((int)eFunction, 40);
 	paramTable_.add_entry((int)eVariable, 40);
 	// constant parameters lead to non-interesting code
@@ -163,6 +165,7 @@ Expression::make_random(CGContext &cg_context, const Type* type, const CVQualifi
 	if (type == NULL) {
 		do {
 			type = cg_context.get_effect_context().is_side_effect_free() ? Type::choose_random_nonvoid() : Type::choose_random_nonvoid_nonvolatile();
+			ERROR_GUARD(NULL);
 		} while (type->eType == eStruct && tt == eConstant);
 	}
 	assert(!(no_func && tt == eFunction));
@@ -215,6 +218,7 @@ Expression::make_random(CGContext &cg_context, const Type* type, const CVQualifi
 		break;
 	default: break;
 	}
+	ERROR_GUARD(NULL);
 #if 0
 	if (!cg_context.get_effect_context().is_side_effect_free()) {
 		assert(e->effect.is_side_effect_free());
@@ -296,6 +300,7 @@ Expression::make_random_param(CGContext &cg_context, const Type* type, const CVQ
 		break;
 	default: break;
 	}
+	ERROR_GUARD(NULL);
 
 	if (e->term_type == eConstant || e->term_type == eVariable ||
 		(e->get_invoke() && e->get_invoke()->invoke_type == eFuncCall)) {
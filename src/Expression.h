@@ -162,8 +162,8 @@ private:
 	static void InitExprProbabilityTable();
 	static void InitParamProbabilityTable();
 
-	static DistributionTable exprTable_;
-	static DistributionTable paramTable_;
+	static thread_local DistributionTable exprTable_;
+	static thread_local DistributionTable paramTable_;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
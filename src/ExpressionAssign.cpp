@@ -42,6 +42,7 @@
 #include "Variable.h"
 #include "StringUtils.h"
 #include "Block.h"
+#include "Error.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -54,9 +55,11 @@ ExpressionAssign::make_random(CGContext &cg_context, const Type* type, const CVQ
 	CVQualifiers qf;
 	if (qfer == NULL) {
 		qf = CVQualifiers::random_qualifiers(type, Effect::WRITE, cg_context, true);
+		ERROR_GUARD(NULL);
 		qfer = &qf;
 	}
 	StatementAssign* sa = StatementAssign::make_random(cg_context, type, qfer);
+	ERROR_GUARD(NULL);
 	FactMgr* fm = get_fact_mgr(&cg_context);
 	FactMgr::update_fact_for_assign(sa, fm->global_facts);
 	ExpressionAssign* ea = new ExpressionAssign(sa);
@@ -38,6 +38,7 @@
 #include "CGOptions.h"
 #include "Type.h"
 #include "util.h"
+#include "Error.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -59,7 +60,9 @@ ExpressionComma*
 ExpressionComma::make_random(CGContext &cg_context, const Type* type, const CVQualifiers* qfer)
 {
 	Expression* lhs = Expression::make_random(cg_context, NULL, NULL, false, true);
+	ERROR_GUARD(NULL);
 	Expression* rhs = Expression::make_random(cg_context, type, qfer, false, false);
+	ERROR_GUARD_AND_DEL1(NULL, lhs);
 	// typecast, if needed.
 	if(CGOptions::lang_cpp())
 		cast_if_needed(rhs);
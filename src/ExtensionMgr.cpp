@@ -45,7 +45,7 @@
 
 using namespace std;
 
-AbsExtension *ExtensionMgr::extension_ = NULL;
+thread_local AbsExtension *ExtensionMgr::extension_ = NULL;
 
 void
 ExtensionMgr::CreateExtension()
@@ -126,7 +126,7 @@ void
 ExtensionMgr::OutputTail(ostream &out)
 {
 	if (ExtensionMgr::extension_ == NULL) {
-		out << "    return 0;" << endl;
+		out << "    return 0;" << '\n';
 	}
 	else {
 		ExtensionMgr::extension_->OutputTail(out);
@@ -138,12 +138,12 @@ ExtensionMgr::OutputInit(std::ostream &out)
 {
 	if (ExtensionMgr::extension_ == NULL) {
 		if (CGOptions::accept_argc()) {
-			out << "int main (int argc, char* argv[])" << endl;
+			out << "int main (int argc, char* argv[])" << '\n';
 		}
 		else {
-			out << "int main (void)" << endl;
+			out << "int main (void)" << '\n';
 		}
-		out << "{" << endl;
+		out << "{" << '\n';
 	}
 	else {
 		ExtensionMgr::extension_->OutputInit(out);
@@ -157,7 +157,7 @@ ExtensionMgr::OutputFirstFunInvocation(std::ostream &out, FunctionInvocation *in
 	if (ExtensionMgr::extension_ == NULL) {
         	out << "    ";
         	invoke->Output(out);
-        	out << ";" << endl;
+        	out << ";" << '\n';
 	}
 	else {
 		ExtensionMgr::extension_->OutputFirstFunInvocation(out, invoke);
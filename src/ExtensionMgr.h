@@ -60,7 +60,7 @@ public:
 	static void OutputFirstFunInvocation(std::ostream &out, FunctionInvocation *invoke);
 
 private:
-	static AbsExtension *extension_;
+	static thread_local AbsExtension *extension_;
 
 };
 
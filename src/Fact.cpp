@@ -39,9 +39,11 @@
 #include "ArrayVariable.h"
 #include "StatementAssign.h"
 #include "StatementReturn.h"
+#include "Profiler.h"
 
 using namespace std;
-std::vector<Fact*> Fact::facts_;
+thread_local std::vector<Fact*> Fact::facts_;
+thread_local std::unordered_set<Fact*, Fact::SharedHash, Fact::SharedEqual> Fact::shared_facts_;
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -75,7 +77,7 @@ Fact::OutputAssertion(std::ostream &out, const Statement* s) const
 		}
         out << "assert (";
         Output(out);
-        out << ");" << endl;
+        out << ");" << '\n';
     }
 }
 
@@ -113,6 +115,48 @@ Fact::abstract_fact_for_var_init(const Variable* v)
 	return facts;
 }
 
+/*
+ * structural hash of the (category, variable) the fact is about. subclasses
+ * mix in their lattice values
+ */
+size_t
+Fact::hash(void) const
+{
+	return std::hash<const Variable*>()(get_var()) * 31 + eCat;
+}
+
+Fact*
+Fact::clone(void) const
+{
+	Fact* fact = copy();
+	facts_.push_back(fact);
+	return fact;
+}
+
+Fact*
+Fact::share(Fact* fact)
+{
+	std::pair<std::unordered_set<Fact*, SharedHash, SharedEqual>::iterator, bool> ret;
+	ret = shared_facts_.insert(fact);
+	if (!ret.second) {
+		delete fact;
+	}
+	return *ret.first;
+}
+
+const Fact*
+Fact::make_joined(const Fact* fact, const Fact* other, bool visits)
+{
+	Profiler::count_fact_join();
+	Fact* joined = fact->copy();
+	if (visits) {
+		joined->join_visits(*other);
+	} else {
+		joined->join(*other);
+	}
+	return share(joined);
+}
+
 void
 Fact::doFinalization()
 {
@@ -121,6 +165,11 @@ Fact::doFinalization()
 		delete (*i);
 	}
 	facts_.clear();
+	std::unordered_set<Fact*, SharedHash, SharedEqual>::iterator j;
+	for (j = shared_facts_.begin(); j != shared_facts_.end(); ++j) {
+		delete (*j);
+	}
+	shared_facts_.clear();
 }
 
 // fact manipulating functions
@@ -160,8 +209,15 @@ find_related_fact(const vector<Fact*>& facts, const Fact* new_fact)
     return 0;
 }
 
-// TODO: we really need to free the memory properly while maintain the memory in compact
-// way, i.e., don't allocate a Fact object unless it's absolutely necessary
+const Fact*
+find_related_fact(const FactSet& facts, const Fact* new_fact)
+{
+	int pos = facts.find_related(new_fact);
+	return (pos == -1) ? 0 : facts[pos];
+}
+
+// the joined fact is shared, so merging the same facts over and over again
+// in fixed point iterations doesn't keep allocating new facts
 bool
 merge_fact(FactVec& facts, const Fact* new_fact)
 {
@@ -171,14 +227,8 @@ merge_fact(FactVec& facts, const Fact* new_fact)
         const Fact* f = facts[i];
         if (f->is_related(*new_fact)) {
             if (!f->imply(*new_fact)) {
-				Fact* copy_fact = new_fact->clone();
-                copy_fact->join(*f);
-                facts[i] = copy_fact;
+                facts[i] = Fact::make_joined(new_fact, f);
                 changed = true;
-				// TODO: release the memory for f???
-            }
-            else {
-                //delete new_fact;   // new fact is useless, unsafe to do so???
             }
             break;
         }
@@ -215,6 +265,16 @@ merge_facts(FactVec& facts, const FactVec& new_facts)
 {
     size_t i;
     bool changed = false;
+	Profiler::count_fact_merge();
+	// for big envs, pay once for an index instead of scanning for every new fact
+	if (facts.size() > FactSet::INDEX_THRESHOLD && new_facts.size() > 1) {
+		FactSet env(facts);
+		if (env.merge(new_facts)) {
+			facts = env.get_facts();
+			changed = true;
+		}
+		return changed;
+	}
     for (i=0; i<new_facts.size(); i++) {
 		//new_facts[i]->Output(cout);
         if (merge_fact(facts, new_facts[i])) {
@@ -229,6 +289,18 @@ renew_facts(FactVec& facts, const FactVec& new_facts)
 {
     size_t i;
     bool changed = false;
+	if (facts.size() > FactSet::INDEX_THRESHOLD && new_facts.size() > 1) {
+		FactSet env(facts);
+		for (i=0; i<new_facts.size(); i++) {
+			if (env.renew(new_facts[i])) {
+				changed = true;
+			}
+		}
+		if (changed) {
+			facts = env.get_facts();
+		}
+		return changed;
+	}
     for (i=0; i<new_facts.size(); i++) {
         if (renew_fact(facts, new_facts[i])) {
             changed = true;
@@ -237,31 +309,23 @@ renew_facts(FactVec& facts, const FactVec& new_facts)
     return changed;
 }
 
-vector<Fact*>
-copy_facts(const FactVec& facts_in)
-{
-    size_t i;
-	vector<Fact*> facts_out;
-    for (i=0; i<facts_in.size(); i++) {
-		Fact* f = facts_in[i]->clone();
-        facts_out.push_back(f);
-    }
-	return facts_out;
-}
-
 /*************************************************************
  * combine facts obtained from two visits to the same piece of code
  *************************************************************/
 void
-combine_facts(vector<Fact*>& facts1, const FactVec& facts2)
+combine_facts(FactVec& facts1, const FactVec& facts2)
 {
+	// the facts are shared, and joining a fact with itself changes nothing
+	if (facts1 == facts2) {
+		return;
+	}
     size_t i, j;
     for (i=0; i<facts2.size(); i++) {
 		const Fact* new_fact = facts2[i];
 		for (j=0; j<facts1.size(); j++) {
-			Fact* old_fact = facts1[j];
+			const Fact* old_fact = facts1[j];
 			if (old_fact->is_related(*new_fact)) {
-				old_fact->join_visits(*new_fact);
+				facts1[j] = Fact::make_joined(old_fact, new_fact, true);
 				break;
 			}
 		}
@@ -283,6 +347,29 @@ same_facts(const FactVec& facts1, const FactVec& facts2)
 	return false;
 }
 
+bool
+same_facts(const FactVec& facts1, const FactSet& facts2)
+{
+	return facts2.same(facts1);
+}
+
+bool
+subset_facts(const FactVec& facts1, const FactSet& facts2)
+{
+	if (facts1.size() == facts2.size()) {
+		size_t i;
+		for (i=0; i<facts1.size(); i++) {
+			const Fact* f1 = facts1[i];
+			const Fact* f2 = find_related_fact(facts2, f1);
+			if (f2 == 0 || !f2->imply(*f1)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	return false;
+}
+
 bool
 subset_facts(const FactVec& facts1, const FactVec& facts2)
 {
@@ -300,6 +387,233 @@ subset_facts(const FactVec& facts1, const FactVec& facts2)
 	return false;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+size_t
+FactSet::FactKeyHash::operator()(const FactKey& key) const
+{
+	return std::hash<const Variable*>()(key.second) * 31 + key.first;
+}
+
+FactSet::FactSet(void)
+	: indexed_(false),
+	  has_dups_(false),
+	  hash_(0)
+{
+	// Nothing else to do.
+}
+
+FactSet::FactSet(const FactVec& facts)
+	: indexed_(false),
+	  has_dups_(false),
+	  hash_(0)
+{
+	*this = facts;
+}
+
+/*
+ * the index is not copied, the copy builds its own when it is looked up
+ */
+FactSet::FactSet(const FactSet& facts)
+	: facts_(facts.facts_),
+	  indexed_(false),
+	  has_dups_(false),
+	  hash_(facts.hash_)
+{
+	// Nothing else to do.
+}
+
+FactSet&
+FactSet::operator=(const FactVec& facts)
+{
+	facts_ = facts;
+	index_.clear();
+	indexed_ = false;
+	has_dups_ = false;
+	hash_ = 0;
+	for (size_t i=0; i<facts_.size(); i++) {
+		hash_ += facts_[i]->hash();
+	}
+	return *this;
+}
+
+FactSet&
+FactSet::operator=(const FactSet& facts)
+{
+	if (this != &facts) {
+		facts_ = facts.facts_;
+		index_.clear();
+		indexed_ = false;
+		has_dups_ = false;
+		hash_ = facts.hash_;
+	}
+	return *this;
+}
+
+void
+FactSet::clear(void)
+{
+	facts_.clear();
+	index_.clear();
+	indexed_ = false;
+	has_dups_ = false;
+	hash_ = 0;
+}
+
+void
+FactSet::build_index(void) const
+{
+	index_.clear();
+	index_.reserve(facts_.size());
+	has_dups_ = false;
+	for (size_t i=0; i<facts_.size(); i++) {
+		const Fact* f = facts_[i];
+		// keep the first one, find_related_fact returns the first match too
+		if (!index_.insert(make_pair(FactKey(f->eCat, f->get_var()), i)).second) {
+			has_dups_ = true;
+		}
+	}
+	indexed_ = true;
+}
+
+int
+FactSet::find_related(const Fact* fact) const
+{
+	if (!indexed_) {
+		if (facts_.size() <= INDEX_THRESHOLD) {
+			for (size_t i=0; i<facts_.size(); i++) {
+				if (fact->is_related(*facts_[i])) {
+					return i;
+				}
+			}
+			return -1;
+		}
+		build_index();
+	}
+	std::unordered_map<FactKey, size_t, FactKeyHash>::const_iterator iter;
+	iter = index_.find(FactKey(fact->eCat, fact->get_var()));
+	return (iter == index_.end()) ? -1 : (int)(iter->second);
+}
+
+void
+FactSet::push_back(const Fact* fact)
+{
+	facts_.push_back(fact);
+	hash_ += fact->hash();
+	if (indexed_) {
+		if (!index_.insert(make_pair(FactKey(fact->eCat, fact->get_var()), facts_.size() - 1)).second) {
+			has_dups_ = true;
+		}
+	}
+}
+
+/*
+ * replace a fact with a related one, the index stays valid
+ */
+void
+FactSet::replace(size_t pos, const Fact* fact)
+{
+	hash_ -= facts_[pos]->hash();
+	hash_ += fact->hash();
+	facts_[pos] = fact;
+}
+
+bool
+FactSet::merge(const Fact* fact)
+{
+	int pos = find_related(fact);
+	if (pos == -1) {
+		push_back(fact);
+		return true;
+	}
+	const Fact* f = facts_[pos];
+	if (!f->imply(*fact)) {
+		replace(pos, Fact::make_joined(fact, f));
+		return true;
+	}
+	return false;
+}
+
+bool
+FactSet::merge(const FactVec& facts)
+{
+	bool changed = false;
+	for (size_t i=0; i<facts.size(); i++) {
+		if (merge(facts[i])) {
+			changed = true;
+		}
+	}
+	return changed;
+}
+
+bool
+FactSet::renew(const Fact* fact)
+{
+	int pos = find_related(fact);
+	if (pos == -1) {
+		push_back(fact);
+		return true;
+	}
+	if (fact->equal(*facts_[pos])) {
+		return false;
+	}
+	replace(pos, fact);
+	return true;
+}
+
+/*
+ * same as same_facts(facts, *this). with no duplicated facts in this env,
+ * each fact in the other env can only be equal to the one fact related to it
+ */
+bool
+FactSet::same(const FactVec& facts) const
+{
+	if (facts.size() != facts_.size()) {
+		return false;
+	}
+	if (facts_.size() > INDEX_THRESHOLD) {
+		if (!indexed_) {
+			build_index();
+		}
+		if (!has_dups_) {
+			for (size_t i=0; i<facts.size(); i++) {
+				int pos = find_related(facts[i]);
+				if (pos == -1 || !facts[i]->equal(*facts_[pos])) {
+					return false;
+				}
+			}
+			return true;
+		}
+	}
+	return same_facts(facts, facts_);
+}
+
+/*
+ * when neither env has duplicated facts, same envs have the same hash, so
+ * most mismatches are found without looking at the facts
+ */
+bool
+FactSet::same(const FactSet& facts) const
+{
+	if (facts.size() != facts_.size()) {
+		return false;
+	}
+	if (facts_.size() > INDEX_THRESHOLD) {
+		if (!indexed_) {
+			build_index();
+		}
+		if (!facts.indexed_) {
+			facts.build_index();
+		}
+		if (!has_dups_ && !facts.has_dups_ && hash_ != facts.hash_) {
+			return false;
+		}
+	}
+	return same(facts.facts_);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void
 print_facts(const FactVec& facts)
 {
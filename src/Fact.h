@@ -34,6 +34,8 @@
 
 #include <ostream>
 #include <vector>
+#include <unordered_map>
+#include <unordered_set>
 using namespace std;
 
 enum eFactCategory {
@@ -64,7 +66,8 @@ public:
 
 	virtual ~Fact(void);
 
-	virtual Fact* clone(void) const = 0;
+	// a private copy that may be modified
+	Fact* clone(void) const;
 
 	virtual int join(const Fact& /*fact*/) {return 0; };
 
@@ -84,6 +87,12 @@ public:
 
 	virtual bool equal(const Fact& fact) const { return this == &fact; };
 
+	// structural hash: facts that are equal() must have the same hash
+	virtual size_t hash(void) const;
+
+	// stricter than equal(): the points-to sets must also be in the same order
+	virtual bool identical(const Fact& fact) const = 0;
+
 	virtual void Output(std::ostream &out) const = 0;
 
 	virtual void OutputAssertion(std::ostream &out, const Statement* s = NULL) const;
@@ -100,19 +109,115 @@ public:
 
 	vector<const Fact*> abstract_fact_for_var_init(const Variable* v);
 
+	// the shared fact of the given fact joined with another one, either
+	// with join or join_visits
+	static const Fact* make_joined(const Fact* fact, const Fact* other, bool visits = false);
+
 	static void doFinalization();
 
 	enum eFactCategory eCat;
 
 protected:
-	// keep track all created facts. used for releasing memory in doFinalization
-	static std::vector<Fact*> facts_;
+	// a copy not owned by anyone yet
+	virtual Fact* copy(void) const = 0;
+
+	// hash-consing: take ownership of a newly created fact and return the
+	// shared fact identical to it, releasing the new one if there is already
+	// such a fact. shared facts must not be modified
+	static Fact* share(Fact* fact);
+
+	// keep track of private facts (see clone). used for releasing memory in doFinalization
+	static thread_local std::vector<Fact*> facts_;
+
+private:
+	struct SharedHash {
+		size_t operator()(const Fact* f) const { return f->hash(); }
+	};
+	struct SharedEqual {
+		bool operator()(const Fact* f1, const Fact* f2) const { return f1->identical(*f2); }
+	};
+
+	// the facts created by make_fact and merging, one per value
+	static thread_local std::unordered_set<Fact*, SharedHash, SharedEqual> shared_facts_;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
 typedef std::vector<const Fact*> FactVec;
 typedef FactVec* FactVecP;
 
+/*
+ * A facts env indexed by (category, variable).
+ *
+ * Facts are kept in insertion order, since later generation decisions
+ * iterate over them, but finding the fact related to a given one is a
+ * hash lookup instead of a scan. The env also maintains an order-insensitive
+ * structural hash of its facts, so two envs can be told apart without
+ * comparing them fact by fact.
+ *
+ * The index is only built once the env grows beyond a handful of facts;
+ * small envs are cheaper to scan.
+ */
+class FactSet
+{
+public:
+	FactSet(void);
+	FactSet(const FactVec& facts);
+	FactSet(const FactSet& facts);
+
+	FactSet& operator=(const FactVec& facts);
+	FactSet& operator=(const FactSet& facts);
+
+	operator const FactVec&(void) const { return facts_; }
+	const FactVec& get_facts(void) const { return facts_; }
+
+	size_t size(void) const { return facts_.size(); }
+	bool empty(void) const { return facts_.empty(); }
+	const Fact* operator[](size_t i) const { return facts_[i]; }
+	void clear(void);
+
+	/* position of the first fact related to the given fact, -1 if none */
+	int find_related(const Fact* fact) const;
+
+	/* append a fact without looking for related facts */
+	void push_back(const Fact* fact);
+
+	/* the FactSet counterparts of merge_fact, merge_facts and renew_fact */
+	bool merge(const Fact* fact);
+	bool merge(const FactVec& facts);
+	bool renew(const Fact* fact);
+
+	/* the FactSet counterparts of same_facts */
+	bool same(const FactVec& facts) const;
+	bool same(const FactSet& facts) const;
+
+	size_t hash(void) const { return hash_; }
+
+	/* envs below this size are searched linearly */
+	static const size_t INDEX_THRESHOLD = 8;
+
+private:
+	typedef std::pair<int, const Variable*> FactKey;
+	struct FactKeyHash {
+		size_t operator()(const FactKey& key) const;
+	};
+
+	void build_index(void) const;
+	void replace(size_t pos, const Fact* fact);
+
+	FactVec facts_;
+
+	// (category, variable) -> position of the first fact on them
+	mutable std::unordered_map<FactKey, size_t, FactKeyHash> index_;
+
+	mutable bool indexed_;
+
+	// true if the index has seen two facts on the same (category, variable)
+	mutable bool has_dups_;
+
+	// sum of the structural hashes of all facts
+	size_t hash_;
+};
+
 /******************* Fact Manipulating Functions **********************/
 /* find a fact from facts env */
 int find_fact(const FactVec& facts, const Fact* fact);
@@ -120,6 +225,7 @@ int find_fact(const FactVec& facts, const Fact* fact);
 /* find a specific type of fact (same variable most likely) from facts env */
 const Fact* find_related_fact(const FactVec& facts, const Fact* new_fact);
 const Fact* find_related_fact(const vector<Fact*>& facts, const Fact* new_fact);
+const Fact* find_related_fact(const FactSet& facts, const Fact* new_fact);
 
 /* merge a fact into env */
 bool merge_fact(FactVec& facts, const Fact* new_fact);
@@ -129,9 +235,11 @@ bool merge_facts(FactVec& facts, const FactVec& new_facts);
 
 /* check if two facts env are identical */
 bool same_facts(const FactVec& facts1, const FactVec& facts2);
+bool same_facts(const FactVec& facts1, const FactSet& facts2);
 
 /* check if one facts env is a subset of the other */
 bool subset_facts(const FactVec& facts1, const FactVec& facts2);
+bool subset_facts(const FactVec& facts1, const FactSet& facts2);
 
 /* renew a fact in env (append is absent) */
 bool renew_fact(FactVec& facts, const Fact* new_fact);
@@ -139,11 +247,8 @@ bool renew_fact(FactVec& facts, const Fact* new_fact);
 /* renew facts in new_facts into existing facts env */
 bool renew_facts(FactVec& facts, const FactVec& new_facts);
 
-/* clone an env */
-vector<Fact*> copy_facts(const FactVec& facts_in);
-
 /* combine facts in two env, discard facts not exist in one of them */
-void combine_facts(vector<Fact*>& facts1, const FactVec& facts2);
+void combine_facts(FactVec& facts1, const FactVec& facts2);
 
 /* add a new variable fact to env */
 void add_new_var_fact(const Variable* v, FactVec& facts);
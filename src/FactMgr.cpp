@@ -63,10 +63,11 @@
 #include "ExpressionVariable.h"
 #include "Lhs.h"
 #include "CFGEdge.h"
+#include "Profiler.h"
 
 using namespace std;
 
-std::vector<Fact*> FactMgr::meta_facts;
+thread_local std::vector<Fact*> FactMgr::meta_facts;
 
 void
 FactMgr::add_new_var_fact_and_update_inout_maps(const Block* blk, const Variable* var)
@@ -86,20 +87,21 @@ FactMgr::add_new_var_fact_and_update_inout_maps(const Block* blk, const Variable
 				global_facts.push_back(f);
 			}
 
-			map<const Statement*, FactVec>::iterator iter;
-			for(iter = map_facts_in.begin(); iter != map_facts_in.end(); ++iter) {
-				const Statement* stm = iter->first;
-				if (stm && (stm->in_block(blk) || blk == NULL)) {
-					iter->second.push_back(f);
+			size_t slot;
+			for (slot = 0; slot < map_facts_in.slots(); slot++) {
+				const Statement* stm = map_facts_in.key(slot);
+				if (map_facts_in.has(slot) && stm && (stm->in_block(blk) || blk == NULL)) {
+					map_facts_in.value(slot).push_back(f);
 				}
 			}
-			for(iter = map_facts_out.begin(); iter != map_facts_out.end(); ++iter) {
-				const Statement* stm = iter->first;
+			for (slot = 0; slot < map_facts_out.slots(); slot++) {
+				if (!map_facts_out.has(slot)) continue;
+				const Statement* stm = map_facts_out.key(slot);
 				assert(stm);
 				if (blk) {
 					add_fact_out(stm, f);
 				} else {
-					iter->second.push_back(f);
+					map_facts_out.value(slot).push_back(f);
 				}
 			}
 		}
@@ -217,33 +219,36 @@ void
 FactMgr::setup_in_out_maps(bool first_time)
 {
 	if (first_time) {
-		// first time revisit, create map_facts_in_final and map_facts_out_final with cloned facts
-		map<const Statement*, vector<const Fact*> >::const_iterator iter;
-		for(iter = map_facts_in.begin(); iter != map_facts_in.end(); ++iter) {
-			const Statement* stm = iter->first;
-			const vector<const Fact*>& facts1 = iter->second;
-			map_facts_in_final[stm] = copy_facts(facts1);
+		// first time revisit, create map_facts_in_final and map_facts_out_final. the facts
+		// are shared, combine_facts replaces rather than modifies them
+		size_t slot;
+		for (slot = 0; slot < map_facts_in.slots(); slot++) {
+			if (!map_facts_in.has(slot)) continue;
+			const Statement* stm = map_facts_in.key(slot);
+			map_facts_in_final[stm] = map_facts_in.get_value(slot);
 		}
-		for(iter = map_facts_out.begin(); iter != map_facts_out.end(); ++iter) {
-			const Statement* stm = iter->first;
-			const vector<const Fact*>& facts1 = iter->second;
-			map_facts_out_final[stm] = copy_facts(facts1);
+		for (slot = 0; slot < map_facts_out.slots(); slot++) {
+			if (!map_facts_out.has(slot)) continue;
+			const Statement* stm = map_facts_out.key(slot);
+			map_facts_out_final[stm] = map_facts_out.get_value(slot);
 		}
 	}
 	else {
 		// not the 1st time revisit
 		// combine facts_in and facts_out from this invocation with facts from previous invocations
-		map<const Statement*, vector<Fact*> >::iterator iter;
-		for(iter = map_facts_in_final.begin(); iter != map_facts_in_final.end(); ++iter) {
-			const Statement* stm = iter->first;
-			vector<Fact*>& facts1 = iter->second;
-			const FactVec& facts2 = map_facts_in[stm];
+		size_t slot;
+		for (slot = 0; slot < map_facts_in_final.slots(); slot++) {
+			if (!map_facts_in_final.has(slot)) continue;
+			const Statement* stm = map_facts_in_final.key(slot);
+			FactVec& facts1 = map_facts_in_final.value(slot);
+			const FactVec& facts2 = map_facts_in.get(stm);
 			combine_facts(facts1, facts2);
 		}
-		for(iter = map_facts_out_final.begin(); iter != map_facts_out_final.end(); ++iter) {
-			const Statement* stm = iter->first;
-			vector<Fact*>& facts1 = iter->second;
-			const FactVec& facts2 = map_facts_out[stm];
+		for (slot = 0; slot < map_facts_out_final.slots(); slot++) {
+			if (!map_facts_out_final.has(slot)) continue;
+			const Statement* stm = map_facts_out_final.key(slot);
+			FactVec& facts1 = map_facts_out_final.value(slot);
+			const FactVec& facts2 = map_facts_out.get(stm);
 			combine_facts(facts1, facts2);
 		}
 	}
@@ -251,10 +256,22 @@ FactMgr::setup_in_out_maps(bool first_time)
 	//sanity_check_map();
 }
 
+/*
+ * revisits mostly store the facts a statement already has, skip those so
+ * that the undo log only saves the statements that change
+ */
+static void
+assign_facts(StatementMap<FactSet>& m, const Statement* s, const FactVec& facts)
+{
+	if (m.get(s).get_facts() != facts) {
+		m[s] = facts;
+	}
+}
+
 void
 FactMgr::set_fact_in(const Statement* s, const FactVec& facts)
 {
-	map_facts_in[s] = facts;
+	assign_facts(map_facts_in, s, facts);
 }
 
 /*
@@ -268,21 +285,21 @@ FactMgr::set_fact_out(const Statement* s, const FactVec& facts)
 	if (s->eType == eContinue || s->eType == eBreak) {
 		FactVec facts_copy = facts;
 		remove_loop_local_facts(s, facts_copy);
-		map_facts_out[s] = facts_copy;
+		assign_facts(map_facts_out, s, facts_copy);
 	}
 	else if (s->eType == eGoto) {
 		const StatementGoto* sg = dynamic_cast<const StatementGoto*>(s);
 		FactVec facts_copy;
 		FactMgr::update_facts_for_dest(facts, facts_copy, sg->dest);
-		map_facts_out[s] = facts_copy;
+		assign_facts(map_facts_out, s, facts_copy);
 	}
 	else if (s->eType == eReturn || s->parent==NULL) {
 		FactVec facts_copy = facts;
 		remove_function_local_facts(facts_copy, s);
-		map_facts_out[s] = facts_copy;
+		assign_facts(map_facts_out, s, facts_copy);
 	}
 	else {
-		map_facts_out[s] = facts;
+		assign_facts(map_facts_out, s, facts);
 	}
 }
 
@@ -444,6 +461,7 @@ FactMgr::update_facts_for_dest(const FactVec& facts_in, FactVec& facts_out, cons
 	vector<const Variable*> oos_vars;
 	const Function* func = dest->func;
 	assert(func);
+	FactSet env(facts_out);
 	// find all the variales that are out-of-scope after jump to destination
 	// oos variables are those not on stack and not global
 	for (i=0; i<facts_in.size(); i++) {
@@ -467,8 +485,9 @@ FactMgr::update_facts_for_dest(const FactVec& facts_in, FactVec& facts_out, cons
 				}
 			}
 		}
-		merge_fact(facts_out, f);
+		env.merge(f);
 	}
+	facts_out = env.get_facts();
 	FactMgr::update_facts_for_oos_vars(oos_vars, facts_out);
 }
 
@@ -478,7 +497,12 @@ FactMgr::update_facts_for_dest(const FactVec& facts_in, FactVec& facts_out, cons
  *
  */
 FactMgr::FactMgr(const Function* f)
-: func(f)
+: fixed_point_cnt(0),
+  fixed_point_rounds(0),
+  max_fixed_point_rounds(0),
+  stm_analysis_cnt(0),
+  stm_shortcut_cnt(0),
+  func(f)
 {
 }
 
@@ -538,31 +562,30 @@ FactMgr::makeup_new_var_facts(vector<const Fact*>& old_facts, const vector<const
 void
 FactMgr::clear_map_visited(void)
 {
-	map<const Statement*, bool>::iterator iter;
-	for(iter = map_visited.begin(); iter != map_visited.end(); ++iter) {
-		iter->second = false;
+	for (size_t slot = 0; slot < map_visited.slots(); slot++) {
+		map_visited.value(slot) = false;
 	}
 }
 
 void
-FactMgr::backup_stm_fact_maps(const Statement* stm, map<const Statement*, FactVec>& facts_in, map<const Statement*, FactVec>& facts_out)
+FactMgr::backup_stm_fact_maps(const Statement* stm, map<const Statement*, FactSet>& facts_in, map<const Statement*, FactSet>& facts_out)
 {
 	vector<const Block*> blks;
 	stm->get_blocks(blks);
 	for (size_t i=0; i<blks.size(); i++) {
 		const Block* b = blks[i];
-		facts_in[b] = map_facts_in[b];
-		facts_out[b] = map_facts_out[b];
+		facts_in[b] = map_facts_in.get(b);
+		facts_out[b] = map_facts_out.get(b);
 		for (size_t j=0; j<b->stms.size(); j++) {
 			backup_stm_fact_maps(b->stms[j], facts_in, facts_out);
 		}
 	}
-	facts_in[stm] = map_facts_in[stm];
-	facts_out[stm] = map_facts_out[stm];
+	facts_in[stm] = map_facts_in.get(stm);
+	facts_out[stm] = map_facts_out.get(stm);
 }
 
 void
-FactMgr::restore_stm_fact_maps(const Statement* stm, map<const Statement*, FactVec>& facts_in, map<const Statement*, FactVec>& facts_out)
+FactMgr::restore_stm_fact_maps(const Statement* stm, map<const Statement*, FactSet>& facts_in, map<const Statement*, FactSet>& facts_out)
 {
 	vector<const Block*> blks;
 	stm->get_blocks(blks);
@@ -578,6 +601,37 @@ FactMgr::restore_stm_fact_maps(const Statement* stm, map<const Statement*, FactV
 	map_facts_out[stm] = facts_out[stm];
 }
 
+/*
+ * start a transaction over map_facts_in, map_facts_out, map_stm_effect and
+ * map_accum_effect. A rollback puts back only the statements looked up since.
+ */
+void
+FactMgr::checkpoint(void)
+{
+	map_facts_in.checkpoint();
+	map_facts_out.checkpoint();
+	map_stm_effect.checkpoint();
+	map_accum_effect.checkpoint();
+}
+
+void
+FactMgr::commit(void)
+{
+	map_facts_in.commit();
+	map_facts_out.commit();
+	map_stm_effect.commit();
+	map_accum_effect.commit();
+}
+
+void
+FactMgr::rollback(void)
+{
+	map_facts_in.rollback();
+	map_facts_out.rollback();
+	map_stm_effect.rollback();
+	map_accum_effect.rollback();
+}
+
 /*
  * reset input/output env of this statement and all statements included to empty
  */
@@ -600,12 +654,13 @@ FactMgr::reset_stm_fact_maps(const Statement* stm)
 }
 
 bool
-FactMgr::merge_jump_facts(FactVec& facts, const FactVec& jump_facts)
+FactMgr::merge_jump_facts(FactVec& facts, const FactSet& jump_facts)
 {
     size_t i;
     bool changed = false;
-    for (i=0; i<facts.size(); i++) {
-		const Fact* f = facts[i];
+	FactSet env(facts);
+    for (i=0; i<env.size(); i++) {
+		const Fact* f = env[i];
 		if (!f->get_var()->is_rv()) {
 			const Fact* jump_f = find_related_fact(jump_facts, f);
 			// this should not happen: jump over initializers
@@ -617,11 +672,14 @@ FactMgr::merge_jump_facts(FactVec& facts, const FactVec& jump_facts)
 					jump_f = FactUnion::make_fact(f->get_var(), FactUnion::BOTTOM);
 				}
 			}
-			if (jump_f && merge_fact(facts, jump_f)) {
+			if (jump_f && env.merge(jump_f)) {
 				changed = true;
 			}
 		}
     }
+	if (changed) {
+		facts = env.get_facts();
+	}
     return changed;
 }
 
@@ -651,7 +709,7 @@ FactMgr::remove_loop_local_facts(const Statement* s, FactVec& facts)
 void
 FactMgr::output_assertions(std::ostream &out, const Statement* stm, int indent, bool post_condition)
 {
-	vector<Fact*> facts;
+	vector<const Fact*> facts;
 	if (!post_condition) {
 		facts = map_facts_in_final[stm];
 	} else {
@@ -688,8 +746,8 @@ FactMgr::output_assertions(std::ostream &out, const Statement* stm, int indent,
 void
 FactMgr::find_updated_facts(const Statement* stm, vector<const Fact*>& facts)
 {
-	const FactVec& facts_in = map_facts_in[stm];
-	const FactVec& facts_out = map_facts_out[stm];
+	const FactSet& facts_in = map_facts_in.get(stm);
+	const FactVec& facts_out = map_facts_out.get(stm);
 
 	for (size_t i=0; i<facts_out.size(); i++) {
 		const Fact* f = facts_out[i];
@@ -702,13 +760,13 @@ FactMgr::find_updated_facts(const Statement* stm, vector<const Fact*>& facts)
 }
 
 void
-FactMgr::find_updated_final_facts(const Statement* stm, vector<Fact*>& facts)
+FactMgr::find_updated_final_facts(const Statement* stm, vector<const Fact*>& facts)
 {
-	vector<Fact*>& facts_in = map_facts_in_final[stm];
-	vector<Fact*>& facts_out = map_facts_out_final[stm];
+	const FactVec& facts_in = map_facts_in_final[stm];
+	const FactVec& facts_out = map_facts_out_final[stm];
 
 	for (size_t i=0; i<facts_out.size(); i++) {
-		Fact* f = facts_out[i];
+		const Fact* f = facts_out[i];
 		// sometimes there is no pre-facts for return variables, so we don't
 		// check the difference
 		if (func->rv->match(f->get_var())) {
@@ -740,13 +798,38 @@ FactMgr::find_dangling_global_ptrs(Function* f)
 	}
 }
 
+/*
+ * record a fixed point that is reached (or given up on) after <rounds> rounds
+ * of visiting the statements of a block
+ */
+void
+FactMgr::count_fixed_point(int rounds)
+{
+	fixed_point_cnt++;
+	fixed_point_rounds += rounds;
+	if (rounds > max_fixed_point_rounds) {
+		max_fixed_point_rounds = rounds;
+	}
+	Profiler::count_fixed_point(rounds);
+}
+
+void
+FactMgr::output_fixed_point_statistics(std::ostream &out) const
+{
+	out << func->name << ": " << fixed_point_cnt << " fixed points in "
+		<< fixed_point_rounds << " rounds (max " << max_fixed_point_rounds << "), "
+		<< stm_analysis_cnt << " statements analyzed, "
+		<< stm_shortcut_cnt << " bypassed" << '\n';
+}
+
 void
 FactMgr::sanity_check_map() const
 {
-	map<const Statement*, vector<const Fact*> >::const_iterator iter;
-	for(iter = map_facts_in.begin(); iter != map_facts_in.end(); ++iter) {
-		const Statement* stm = iter->first;
-		const vector<const Fact*>& facts = iter->second;
+	size_t slot;
+	for (slot = 0; slot < map_facts_in.slots(); slot++) {
+		if (!map_facts_in.has(slot)) continue;
+		const Statement* stm = map_facts_in.key(slot);
+		const FactVec& facts = map_facts_in.get_value(slot);
 		for (size_t i=0; i<facts.size(); i++) {
 			const Variable* v = facts[i]->get_var();
 			if (!v->is_visible(stm->parent)) {
@@ -759,9 +842,10 @@ FactMgr::sanity_check_map() const
 		}
 	}
 
-	for(iter = map_facts_out.begin(); iter != map_facts_out.end(); ++iter) {
-		const Statement* stm = iter->first;
-		const vector<const Fact*>& facts = iter->second;
+	for (slot = 0; slot < map_facts_out.slots(); slot++) {
+		if (!map_facts_out.has(slot)) continue;
+		const Statement* stm = map_facts_out.key(slot);
+		const FactVec& facts = map_facts_out.get_value(slot);
 		for (size_t i=0; i<facts.size(); i++) {
 			const Variable* v = facts[i]->get_var();
 			if (!v->is_visible(stm->parent) && !func->rv->match(v)) {
@@ -783,6 +867,8 @@ FactMgr::doFinalization()
 {
 	Fact::doFinalization();
 	meta_facts.clear();
+	FactPointTo::all_ptrs.clear();
+	FactPointTo::all_aliases.clear();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -58,6 +58,7 @@ class CFGEdge;
 #include <map>
 #include "Effect.h"
 #include "Fact.h"
+#include "StatementMap.h"
 using namespace std;
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -96,12 +97,17 @@ public:
 	void create_cfg_edge(const Statement* src, const Statement* dest, bool post_stm_edge, bool back_link);
 
 	void clear_map_visited(void);
-	void backup_stm_fact_maps(const Statement* stm, map<const Statement*, FactVec>& facts_in, map<const Statement*, FactVec>& facts_out);
-	void restore_stm_fact_maps(const Statement* stm, map<const Statement*, FactVec>& facts_in, map<const Statement*, FactVec>& facts_out);
+	void backup_stm_fact_maps(const Statement* stm, map<const Statement*, FactSet>& facts_in, map<const Statement*, FactSet>& facts_out);
+	void restore_stm_fact_maps(const Statement* stm, map<const Statement*, FactSet>& facts_in, map<const Statement*, FactSet>& facts_out);
 	void reset_stm_fact_maps(const Statement* stm);
 
+	/* transactions over the facts and effects of the statements */
+	void checkpoint(void);
+	void commit(void);
+	void rollback(void);
+
 	void output_assertions(std::ostream &out, const Statement* stm, int indent, bool post_condition);
-	void find_updated_final_facts(const Statement* stm, vector<Fact*>& facts);
+	void find_updated_final_facts(const Statement* stm, vector<const Fact*>& facts);
 	void find_updated_facts(const Statement* stm, vector<const Fact*>& facts);
 
 	void find_dangling_global_ptrs(Function* f);
@@ -116,7 +122,7 @@ public:
 	static void remove_loop_local_facts(const Statement* s, FactVec& facts);
 	/* remove facts localized to a given function up to a given return statement */
 	static void remove_function_local_facts(std::vector<const Fact*>& inputs, const Statement* stm);
-	static bool merge_jump_facts(FactVec& facts, const FactVec& jump_facts);
+	static bool merge_jump_facts(FactVec& facts, const FactSet& jump_facts);
 	/* add a new variable fact to env */
 	static void add_new_var_fact(const Variable* v, FactVec& facts);
 	static const vector<const Fact*>& get_program_end_facts(void);
@@ -137,21 +143,31 @@ public:
 
 	void sanity_check_map() const;
 
-	static std::vector<Fact*> meta_facts;
+	void count_fixed_point(int rounds);
+	void output_fixed_point_statistics(std::ostream &out) const;
+
+	static thread_local std::vector<Fact*> meta_facts;
 
 	// maps to track facts and effects at historical generation points.
 	// they are used for bypassing analyzing statements if possible
-	std::map<const Statement*, FactVec> map_facts_in;
-	std::map<const Statement*, FactVec> map_facts_out;
-	std::map<const Statement*, std::vector<Fact*> > map_facts_in_final;
-	std::map<const Statement*, std::vector<Fact*> > map_facts_out_final;
-	std::map<const Statement*, Effect> map_stm_effect;
-	std::map<const Statement*, Effect> map_accum_effect;
-	std::map<const Statement*, bool> map_visited;
+	StatementMap<FactSet> map_facts_in;
+	StatementMap<FactSet> map_facts_out;
+	StatementMap<FactVec> map_facts_in_final;
+	StatementMap<FactVec> map_facts_out_final;
+	StatementMap<Effect> map_stm_effect;
+	StatementMap<Effect> map_accum_effect;
+	StatementMap<bool> map_visited;
 
 	std::vector<const CFGEdge*> cfg_edges;
 	FactVec global_facts;
 
+	// dataflow work done for this function, see Block::find_fixed_point
+	int fixed_point_cnt;
+	int fixed_point_rounds;
+	int max_fixed_point_rounds;
+	int stm_analysis_cnt;	// statements analyzed
+	int stm_shortcut_cnt;	// statements bypassed because their inputs did not change
+
 	const Function* func;
 };
 
@@ -63,8 +63,8 @@ using namespace std;
 const Variable* FactPointTo::null_ptr = VariableSelector::make_dummy_static_variable("null");
 const Variable* FactPointTo::garbage_ptr = VariableSelector::make_dummy_static_variable("garbage");
 const Variable* FactPointTo::tbd_ptr = VariableSelector::make_dummy_static_variable("tbd");
-vector<const Variable*> FactPointTo::all_ptrs;
-vector<vector<const Variable*> > FactPointTo::all_aliases;
+thread_local vector<const Variable*> FactPointTo::all_ptrs;
+thread_local vector<vector<const Variable*> > FactPointTo::all_aliases;
 
 bool
 FactPointTo::is_null() const
@@ -306,35 +306,27 @@ FactPointTo::abstract_fact_for_assign(const std::vector<const Fact*>& facts_in,
 }
 
 Fact*
-FactPointTo::clone(void) const
+FactPointTo::copy(void) const
 {
-	FactPointTo *fact = new FactPointTo(var, point_to_vars);
-	facts_.push_back(fact);
-	return fact;
+	return new FactPointTo(var, point_to_vars);
 }
 
 FactPointTo *
 FactPointTo::make_fact(const Variable *v)
 {
-	FactPointTo *fact = new FactPointTo(v);
-	facts_.push_back(fact);
-	return fact;
+	return static_cast<FactPointTo*>(share(new FactPointTo(v)));
 }
 
 FactPointTo *
 FactPointTo::make_fact(const Variable* v, const vector<const Variable*>& set)
 {
-	FactPointTo *fact = new FactPointTo(v, set);
-	facts_.push_back(fact);
-	return fact;
+	return static_cast<FactPointTo*>(share(new FactPointTo(v, set)));
 }
 
 FactPointTo *
 FactPointTo::make_fact(const Variable* v, const Variable* point_to)
 {
-	FactPointTo *fact = new FactPointTo(v, point_to);
-	facts_.push_back(fact);
-	return fact;
+	return static_cast<FactPointTo*>(share(new FactPointTo(v, point_to)));
 }
 
 vector<const Fact*>
@@ -575,6 +567,29 @@ FactPointTo::equal(const Fact& f) const
     return false;
 }
 
+bool
+FactPointTo::identical(const Fact& f) const
+{
+	if (eCat == f.eCat) {
+		const FactPointTo& fact = (const FactPointTo&)f;
+		return var == fact.get_var() && point_to_vars == fact.get_point_to_vars();
+	}
+	return false;
+}
+
+/*
+ * the point-to set is unordered, so combine the pointees commutatively
+ */
+size_t
+FactPointTo::hash(void) const
+{
+	size_t h = 0;
+	for (size_t i=0; i<point_to_vars.size(); i++) {
+		h += std::hash<const Variable*>()(point_to_vars[i]) * 0x9e3779b97f4a7c15ULL;
+	}
+	return Fact::hash() * 31 + h;
+}
+
 /*
  * return 1 if changed, 0 otherwise
  */
@@ -806,7 +821,7 @@ FactPointTo::update_facts_with_modified_index(std::vector<const Fact*>& facts, c
 }
 
 void
-FactPointTo::update_ptr_aliases(const vector<Fact*>& facts, vector<const Variable*>& ptrs, vector<vector<const Variable*> >& aliases)
+FactPointTo::update_ptr_aliases(const vector<const Fact*>& facts, vector<const Variable*>& ptrs, vector<vector<const Variable*> >& aliases)
 {
 	size_t i, j;
 	for (j=0; j<facts.size(); j++) {
@@ -844,9 +859,8 @@ FactPointTo::aggregate_all_pointto_sets(void)
 		if (funcs[i]->is_builtin)
 			continue;
 		FactMgr* fm = get_fact_mgr_for_func(funcs[i]);
-		map<const Statement*, vector<Fact*> >::iterator iter;
-		for(iter = fm->map_facts_out_final.begin(); iter != fm->map_facts_out_final.end(); ++iter) {
-			update_ptr_aliases(iter->second, all_ptrs, all_aliases);
+		for (size_t slot = 0; slot < fm->map_facts_out_final.slots(); slot++) {
+			update_ptr_aliases(fm->map_facts_out_final.get_value(slot), all_ptrs, all_aliases);
 		}
 	}
 	assert(all_ptrs.size() == all_aliases.size());
@@ -84,10 +84,11 @@ public:
 
 	virtual int join(const Fact& fact);
 	virtual int join_visits(const Fact& fact);
-	virtual Fact* clone(void) const;
 	virtual bool imply(const Fact& fact) const;
 	virtual bool point_to(const Variable* v) const;
 	virtual bool equal(const Fact& fact) const;
+	virtual size_t hash(void) const;
+	virtual bool identical(const Fact& fact) const;
 	virtual void Output(std::ostream &out) const;
 	virtual bool is_assertable(const Statement* s) const;
 
@@ -110,8 +111,12 @@ public:
 	static const Variable* garbage_ptr;
 	static const Variable* tbd_ptr;
 
-	static vector<const Variable*> all_ptrs;
-	static vector<vector<const Variable*> > all_aliases;
+	static thread_local vector<const Variable*> all_ptrs;
+	static thread_local vector<vector<const Variable*> > all_aliases;
+
+protected:
+	virtual Fact* copy(void) const;
+
 private:
 	FactPointTo(const Variable* v, const vector<const Variable*>& set);
 	FactPointTo(const Variable* v, const Variable* point_to);
@@ -119,7 +124,7 @@ private:
 	const Variable* var;
 	vector<const Variable*> point_to_vars;
 
-	static void update_ptr_aliases(const vector<Fact*>& facts, vector<const Variable*>& ptrs, vector<vector<const Variable*> >& aliases);
+	static void update_ptr_aliases(const vector<const Fact*>& facts, vector<const Variable*>& ptrs, vector<vector<const Variable*> >& aliases);
 
 	// unimplement
 	FactPointTo(const FactPointTo& f);
@@ -157,20 +157,16 @@ FactUnion::abstract_fact_for_assign(const std::vector<const Fact*>& facts, const
 }
 
 Fact*
-FactUnion::clone(void) const
+FactUnion::copy(void) const
 {
-	FactUnion *fact = new FactUnion(var, last_written_fid);
-	facts_.push_back(fact);
-	return fact;
+	return new FactUnion(var, last_written_fid);
 }
 
 FactUnion *
 FactUnion::make_fact(const Variable* v, int fid)
 {
 	assert(v == NULL || v->type->eType == eUnion);
-	FactUnion *fact = new FactUnion(v, fid);
-	facts_.push_back(fact);
-	return fact;
+	return static_cast<FactUnion*>(share(new FactUnion(v, fid)));
 }
 
 vector<const Fact*>
@@ -69,6 +69,8 @@ public:
 	virtual void set_bottom(void) { last_written_fid = BOTTOM;}
 	virtual bool imply(const Fact& fact) const;
 	virtual bool equal(const Fact& fact) const;
+	virtual size_t hash(void) const { return Fact::hash() * 31 + last_written_fid; }
+	virtual bool identical(const Fact& fact) const { return equal(fact); }
 	virtual int join(const Fact& fact);
 
 	// transfer functions
@@ -76,7 +78,6 @@ public:
 	virtual int abstract_fact_for_assign(const std::vector<const Fact*>& /*facts*/, const Lhs* /*lhs*/, const Expression* /*rhs*/, std::vector<const Fact*>&);
 	//virtual vector<const Fact*> abstract_fact_for_return(const std::vector<const Fact*>& facts, const ExpressionVariable* rv, const Function* func);
 	virtual Fact* join_var_facts(const vector<const Fact*>& facts, const vector<const Variable*>& vars) const;
-	virtual Fact* clone(void) const;
 
 	// output functions
 	virtual bool is_assertable(const Statement* /*s*/) const { return false;}
@@ -86,6 +87,10 @@ public:
 	// constants to indicate lattice top/bottom
 	static const int TOP;
 	static const int BOTTOM;
+
+protected:
+	virtual Fact* copy(void) const;
+
 private:
 	FactUnion(const Variable* v);
 	FactUnion(const Variable* v, int fid);
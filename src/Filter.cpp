@@ -67,6 +67,19 @@ void Filter::disable(FilterKind kind)
 	kinds_[kind] = false;
 }
 
+/*
+ * Good for the filters without side effects, the others override it
+ */
+bool
+Filter::admissible(unsigned int n, std::vector<unsigned int> &values) const
+{
+	for (unsigned int v = 0; v < n; v++) {
+		if (!filter(v))
+			values.push_back(v);
+	}
+	return true;
+}
+
 /*
  *
  */
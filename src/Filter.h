@@ -31,6 +31,7 @@
 #define FILTER_H
 
 #include <bitset>
+#include <vector>
 
 enum FilterKind {
 	fDefault,
@@ -48,6 +49,11 @@ public:
 
 	virtual bool filter(int v) const = 0;
 
+	// Collect the values in [0, n) that pass the filter, so that one of them
+	// can be drawn directly. Must not have side effects: filter() is called
+	// again on the value drawn. Returns false if the values can't be listed.
+	virtual bool admissible(unsigned int n, std::vector<unsigned int> &values) const;
+
 	void enable(FilterKind kind);
 
 	void disable(FilterKind kind);
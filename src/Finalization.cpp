@@ -42,6 +42,15 @@
 #include "Probabilities.h"
 #include "StatementGoto.h"
 #include "ExtensionMgr.h"
+#include "ArrayVariable.h"
+#include "SafeOpFlags.h"
+#include "Error.h"
+#include "util.h"
+#include "Profiler.h"
+#include "DecisionTrace.h"
+#include "DFSDuplicateChecker.h"
+#include "Budget.h"
+#include "TargetSize.h"
 
 void
 Finalization::doFinalization()
@@ -54,6 +63,17 @@ Finalization::doFinalization()
 	FunctionInvocationUser::doFinalization();
 	Probabilities::DestroyInstance();
 	StatementGoto::doFinalization();
+	Statement::doFinalization();
+	ArrayVariable::doFinalization();
+	Bookkeeper::doFinalization();
+	Profiler::doFinalization();
+	DecisionTrace::doFinalization();
+	DFSDuplicateChecker::doFinalization();
+	Budget::doFinalization();
+	TargetSize::doFinalization();
 	ExtensionMgr::DestroyExtension();
+	SafeOpFlags::wrapper_names.clear();
+	Error::set_error(SUCCESS);
+	reset_gensym();
 }
 
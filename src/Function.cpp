@@ -66,18 +66,25 @@
 #include "DepthSpec.h"
 #include "ExtensionMgr.h"
 #include "OutputMgr.h"
+#include "AbsProgramGenerator.h"
 #include "Attribute.h"
+#include "Profiler.h"
+#include "DFSDuplicateChecker.h"
+#include "CallGraph.h"
+#include "CallSummaryCache.h"
+#include "Budget.h"
+#include "TargetSize.h"
 
 using namespace std;
 
 ///////////////////////////////////////////////////////////////////////////////
 
-AttributeGenerator func_attr_generator;
-static vector<Function*> FuncList;		// List of all functions in the program
-static vector<FactMgr*>  FMList;        // list of fact managers for each function
-static long cur_func_idx;				// Index into FuncList that we are currently working on
-static bool param_first=true;			// Flag to track output of commas
-static int builtin_functions_cnt;
+thread_local AttributeGenerator func_attr_generator;
+static thread_local vector<Function*> FuncList;		// List of all functions in the program
+static thread_local vector<FactMgr*>  FMList;        // list of fact managers for each function
+static thread_local long cur_func_idx;				// Index into FuncList that we are currently working on
+static thread_local bool param_first=true;			// Flag to track output of commas
+static thread_local int builtin_functions_cnt;
 
 static std::vector<string> common_func_attributes;
 
@@ -107,12 +114,7 @@ Function::InitializeAttributes()
 FactMgr*
 get_fact_mgr_for_func(const Function* func)
 {
-	for (size_t i=0; i<FuncList.size(); i++) {
-		if (FuncList[i] == func) {
-			return FMList[i];
-		}
-	}
-    return 0;
+	return func ? func->fm : 0;
 }
 
 /*
@@ -222,7 +224,8 @@ Function::is_var_oos(const Variable* var, const Statement* stm) const
 bool
 Function::reach_max_functions_cnt()
 {
-	return ((static_cast<int>(FuncList.size()) - builtin_functions_cnt) >= CGOptions::max_funcs());
+	return ((static_cast<int>(FuncList.size()) - builtin_functions_cnt) >= CGOptions::max_funcs()) ||
+		Budget::reached() || TargetSize::large_enough();
 }
 
 const vector<Function*>&
@@ -411,11 +414,13 @@ Function::Function(const string &name, const Type *return_type)
 	: name(name),
 	  return_type(return_type),
 	  body(0),
+	  fm(0),
 	  fact_changed(false),
 	  union_field_read(false),
 	  is_inlined(false),
 	  is_builtin(false),
 	  visited_cnt(0),
+	  stm_cnt(1),
 	  build_state(UNBUILT)
 {
 	FuncList.push_back(this);			// Add to global list of functions.
@@ -425,11 +430,13 @@ Function::Function(const string &name, const Type *return_type, bool builtin)
 	: name(name),
 	  return_type(return_type),
 	  body(0),
+	  fm(0),
 	  fact_changed(false),
 	  union_field_read(false),
 	  is_inlined(false),
 	  is_builtin(builtin),
 	  visited_cnt(0),
+	  stm_cnt(1),
 	  build_state(UNBUILT)
 {
 	FuncList.push_back(this);			// Add to global list of functions.
@@ -438,6 +445,7 @@ Function::Function(const string &name, const Type *return_type, bool builtin)
 Function *
 Function::make_random_signature(const CGContext& cg_context, const Type* type, const CVQualifiers* qfer)
 {
+	RandomStreamScope stream(rsFunctions);
 	if (type == 0)
 		type = RandomReturnType();
 
@@ -453,7 +461,8 @@ Function::make_random_signature(const CGContext& cg_context, const Type* type, c
 	ERROR_GUARD(NULL);
 	f->rv = Variable::CreateVariable(rvname, type, NULL, &ret_qfer);
 	GenerateParameterList(*f);
-	FMList.push_back(new FactMgr(f));
+	f->fm = new FactMgr(f);
+	FMList.push_back(f->fm);
 	if (CGOptions::inline_function() && rnd_flipcoin(InlineFunctionProb))
 		f->is_inlined = true;
 	return f;
@@ -478,6 +487,7 @@ Function::make_random(const CGContext& cg_context, const Type* type, const CVQua
 Function *
 Function::make_first(void)
 {
+	RandomStreamScope stream(rsFunctions);
 	const Type *ty = RandomReturnType();
 	ERROR_GUARD(NULL);
 
@@ -491,18 +501,20 @@ Function::make_first(void)
 
 	// create a fact manager for this function, with empty global facts
 	FactMgr* fm = new FactMgr(f);
+	f->fm = fm;
 	FMList.push_back(fm);
 
 	ExtensionMgr::GenerateFirstParameterList(*f);
 
 	// No Parameter List
 	f->GenerateBody(CGContext::get_empty_context());
+	ERROR_GUARD(NULL);
 	if (CGOptions::inline_function() && rnd_flipcoin(InlineFunctionProb))
 		f->is_inlined = true;
 	fm->setup_in_out_maps(true);
 
 	// update global facts to merged facts at all possible function exits
-	fm->global_facts = fm->map_facts_out[f->body];
+	fm->global_facts = fm->map_facts_out.get(f->body);
 	f->body->add_back_return_facts(fm, fm->global_facts);
 
 	// collect info about global dangling pointers
@@ -682,6 +694,8 @@ Function::GenerateBody(const CGContext &prev_context)
 		return;
 	}
 
+	ProfileScope scope(Profiler::pGenerateBody);
+	RandomStreamScope stream(rsFunctions);
 	build_state = BUILDING;
 	Effect effect_accum;
 	CGContext cg_context(this, prev_context.get_effect_context(), &effect_accum);
@@ -699,6 +713,7 @@ Function::GenerateBody(const CGContext &prev_context)
 		body = Block::make_random(cg_context);
 	ERROR_RETURN();
 	body->set_depth_protect(true);
+	CallGraph::add_function(this);
 
 	// compute the pointers that are statically referenced in the function
 	// including ones referenced by its callees
@@ -707,7 +722,7 @@ Function::GenerateBody(const CGContext &prev_context)
 	// Compute the function's externally visible effect.  Currently, this
 	// is just the effect on globals.
 	//effect.add_external_effect(*cg_context.get_effect_accum());
-	feffect.add_external_effect(fm->map_stm_effect[body]);
+	feffect.add_external_effect(fm->map_stm_effect.get(body));
 
 	make_return_const();
 	ERROR_RETURN();
@@ -724,6 +739,8 @@ Function::generate_body_with_known_params(const CGContext &prev_context, Effect&
 		return;
 	}
 
+	ProfileScope scope(Profiler::pGenerateBody);
+	RandomStreamScope stream(rsFunctions);
 	build_state = BUILDING;
 	FactMgr* fm = get_fact_mgr_for_func(this);
 	CGContext cg_context(this, prev_context.get_effect_context(), &effect_accum);
@@ -814,13 +831,14 @@ Function::make_builtin_function(const string &function_string)
 
 	// create a fact manager for this function, with empty global facts
 	FactMgr* fm = new FactMgr(f);
+	f->fm = fm;
 	FMList.push_back(fm);
 
 	GenerateParameterListFromString(*f, StringUtils::get_substring(v[2], '(', ')'));
 	f->GenerateBody(CGContext::get_empty_context());
 
 	// update global facts to merged facts at all possible function exits
-	fm->global_facts = fm->map_facts_out[f->body];
+	fm->global_facts = fm->map_facts_out.get(f->body);
 	f->body->add_back_return_facts(fm, fm->global_facts);
 
 	// collect info about global dangling pointers
@@ -832,16 +850,23 @@ void
 Function::compute_summary(void)
 {
 	FactMgr* fm = get_fact_mgr_for_func(this);
+	// the callees are finished, and so are their summaries
+	CallGraph::add_function(this);
+
 	// compute the pointers that are statically referenced in the function
 	// including ones referenced by its callees
 	body->get_referenced_ptrs(referenced_ptrs);
 
 	// Compute the function's externally visible effect.
 	//effect.add_external_effect(*cg_context.get_effect_accum());
-	feffect.add_external_effect(fm->map_stm_effect[body]);
+	feffect.add_external_effect(fm->map_stm_effect.get(body));
 
-	// determine whether an union field is read
-	union_field_read = body->read_union_field();
+	// determine whether an union field is read, here or in a callee
+	union_field_read = fm->map_stm_effect.get(body).union_field_is_read();
+	const vector<const Function*>& callees = CallGraph::get_callees(this);
+	for (size_t i=0; i<callees.size() && !union_field_read; i++) {
+		union_field_read = callees[i]->union_field_read;
+	}
 }
 
 /*
@@ -855,8 +880,13 @@ GenerateFunctions(void)
 		Function::initialize_builtin_functions();
 	// -----------------
 	// Create a basic first function, then generate a random graph from there.
-	/* Function *first = */ Function::make_first();
+	Function *first = Function::make_first();
 	ERROR_RETURN();
+	first->stream_output();
+	if (CGOptions::dfs_prune_duplicates()) {
+		DFSDuplicateChecker::check_program();
+		ERROR_RETURN();
+	}
 
 	// -----------------
 	// Create body of each function, continue until no new functions are created.
@@ -865,6 +895,11 @@ GenerateFunctions(void)
 		if (FuncList[cur_func_idx]->is_built() == false) {
 			FuncList[cur_func_idx]->GenerateBody(CGContext::get_empty_context());
 			ERROR_RETURN();
+			FuncList[cur_func_idx]->stream_output();
+			if (CGOptions::dfs_prune_duplicates()) {
+				DFSDuplicateChecker::check_program();
+				ERROR_RETURN();
+			}
 		}
 	}
 	FactPointTo::aggregate_all_pointto_sets();
@@ -932,6 +967,20 @@ OutputFunctions(std::ostream &out)
 			 std::bind2nd(std::ptr_fun(OutputFunction), &out));
 }
 
+/*
+ * With --stream-output, write out the function as soon as it is complete.
+ * Its body and facts are still needed to analyze the calls to it that are
+ * generated later, so nothing can be released here. --target-size measures
+ * the function here too.
+ */
+void
+Function::stream_output(void)
+{
+	TargetSize::add_function(this);
+	if (CGOptions::stream_output())
+		AbsProgramGenerator::GetOutputMgr()->OutputFinishedFunction(this);
+}
+
 /*
  * Delete a single function
  */
@@ -958,6 +1007,14 @@ Function::doFinalization(void)
 	}
 	FMList.clear();
 	FactMgr::doFinalization();
+	// both are keyed by the functions just freed
+	CallGraph::doFinalization();
+	CallSummaryCache::doFinalization();
+
+	cur_func_idx = 0;
+	param_first = true;
+	builtin_functions_cnt = 0;
+	func_attr_generator.clear();
 }
 
 Function::~Function()
@@ -85,6 +85,7 @@ public:
 
 	void Output(std::ostream &);
 	void OutputForwardDecl(std::ostream &);
+	void stream_output(void);
 
 	bool is_built(void) const { return (build_state == BUILT); }
 	bool need_return_stmt();
@@ -114,6 +115,7 @@ public:
 	Constant *ret_c;
 
 	Variable* rv;    // a dummy variable representing the return value
+	FactMgr* fm;     // the fact manager of this function
 	std::vector<const Variable*> new_globals;  // collection of global variables created in this function
 	std::vector<const Variable*> dead_globals; // collection of global variables that is dangling at the end of this function
 	bool fact_changed;
@@ -121,6 +123,7 @@ public:
 	bool is_inlined;
 	bool is_builtin;
 	int  visited_cnt;
+	int  stm_cnt;      // number of statements created, used for Statement::stm_index
 	Effect accum_eff_context;
 	void InitializeAttributes();
 
@@ -69,6 +69,7 @@
 #include "DepthSpec.h"
 #include "Constant.h"
 #include "CGOptions.h"
+#include "Profiler.h"
 
 using namespace std;
 
@@ -83,6 +84,7 @@ FunctionInvocation::make_random(bool is_std_func,
 				const Type* type,
 				const CVQualifiers* qfer)
 {
+	ProfileScope scope(Profiler::pInvocation);
 	FunctionInvocation *fi = 0;
 	// If we are looking for a program-defined function, try to find one.
 	if (!is_std_func) {
@@ -100,6 +102,7 @@ FunctionInvocation::make_random(bool is_std_func,
 		}
 		else if (!Function::reach_max_functions_cnt()) {
 			fi = FunctionInvocationUser::build_invocation_and_function(cg_context, type, qfer);
+			ERROR_GUARD(NULL);
 		} else {
 			// we can not find/create a function because we reach the limit, so give up
 			fi = new FunctionInvocationUser(NULL, false, NULL);
@@ -115,6 +118,7 @@ FunctionInvocation::make_random(bool is_std_func,
 		} else {
 			fi = make_random_binary(cg_context, type);
 		}
+		ERROR_GUARD(NULL);
 	}
 	assert(fi != 0);
 	return fi;
@@ -147,8 +151,8 @@ FunctionInvocation::make_random_unary(CGContext &cg_context, const Type* type)
 	eUnaryOps op;
 	do {
 		op = (eUnaryOps)(rnd_upto(MAX_UNARY_OP, UNARY_OPS_PROB_FILTER));
+		ERROR_GUARD(NULL);
 	} while (type->is_float() && !UnaryOpWorksForFloat(op));
-	ERROR_GUARD(NULL);
 	SafeOpFlags *flags = NULL;
 	flags = SafeOpFlags::make_random_unary(type, NULL, op);
 	ERROR_GUARD(NULL);
@@ -179,12 +183,12 @@ FunctionInvocation::make_random_binary(CGContext &cg_context, const Type* type)
 	eBinaryOps op;
 	do {
 		op = (eBinaryOps)(rnd_upto(MAX_BINARY_OP, BINARY_OPS_PROB_FILTER));
+		ERROR_GUARD(NULL);
 	} while (type->is_float() && !BinaryOpWorksForFloat(op));
-	ERROR_GUARD(NULL);
 	assert(type);
 	SafeOpFlags *flags = SafeOpFlags::make_random_binary(type, NULL, NULL, sOpBinary, op);
-	assert(flags);
 	ERROR_GUARD(NULL);
+	assert(flags);
 	FunctionInvocationBinary *fi = FunctionInvocationBinary::CreateFunctionInvocationBinary(cg_context, op, flags);
 
 	Effect lhs_eff_accum;
@@ -239,6 +243,7 @@ FunctionInvocation::make_random_binary(CGContext &cg_context, const Type* type)
 		}
 		else {
 			rhs = Expression::make_random(rhs_cg_context, rhs_type);
+			ERROR_GUARD_AND_DEL2(NULL, fi, lhs);
 			// avoid divide by zero or possible zero (reached by pointer comparison)
 			if ((op == eMod || op == eDiv) && (rhs->equals(0) || rhs->is_0_or_1()) &&
 				!lhs_type->is_float() && !rhs_type->is_float()) {
@@ -508,7 +513,7 @@ FunctionInvocation::visit_facts(vector<const Fact*>& inputs, CGContext& cg_conte
 	bool unordered = false; //has_uncertain_call();
 	bool ok = false;
 	bool is_func_call = (invoke_type == eFuncCall);
-	static int g = 0;
+	static thread_local int g = 0;
 	Effect running_eff_context(cg_context.get_effect_context());
 	if (!unordered) {
 		// unsigned int flags = ptr_cmp ? (cg_context.flags | NO_DANGLING_PTR) : cg_context.flags;
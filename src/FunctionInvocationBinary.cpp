@@ -33,6 +33,7 @@
 
 #include "FunctionInvocationBinary.h"
 #include <cassert>
+#include <sstream>
 
 #include "Common.h"
 
@@ -44,10 +45,11 @@
 #include "CGContext.h"
 #include "Block.h"
 #include "random.h"
+#include "OutputMgr.h"
 
 using namespace std;
 
-static vector<bool> needcomma;  // Flag to track output of commas
+static thread_local vector<bool> needcomma;  // Flag to track output of commas
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -315,12 +317,49 @@ FunctionInvocationBinary::get_binop_string(eBinaryOps bop)
 	return op_string;
 }
 
+/*
+ * In canonical output, print the operands of commutative operators in a
+ * fixed order, so that a + b and b + a compare equal. Not valid C.
+ */
+bool
+FunctionInvocationBinary::output_canonical(std::ostream &out) const
+{
+	switch (eFunc) {
+	case eAdd:
+	case eMul:
+	case eCmpEq:
+	case eCmpNe:
+	case eBitXor:
+	case eBitAnd:
+	case eBitOr:
+		break;
+	default:
+		return false;
+	}
+	std::ostringstream op1, op2;
+	param_value[0]->Output(op1);
+	param_value[1]->Output(op2);
+	std::string s1 = op1.str();
+	std::string s2 = op2.str();
+	if (s2 < s1)
+		s1.swap(s2);
+	out << "(";
+	if (op_flags)
+		op_flags->OutputSize(out);
+	out << " ";
+	OutputStandardFuncName(eFunc, out);
+	out << " " << s1 << ", " << s2 << ")";
+	return true;
+}
+
 /*
  *
  */
 void
 FunctionInvocationBinary::Output(std::ostream &out) const
 {
+	if (OutputMgr::canonical_output() && output_canonical(out))
+		return;
 	bool need_cast = false;
 	out << "(";
 	// special case for mutated array subscripts, see ArrayVariable::rnd_mutate
@@ -397,7 +436,7 @@ FunctionInvocationBinary::Output(std::ostream &out) const
 void
 FunctionInvocationBinary::indented_output(std::ostream &out, int indent) const
 {
-	if (has_simple_params()) {
+	if (has_simple_params() || OutputMgr::canonical_output()) {
 		output_tab(out, indent);
 		Output(out);
 		return;
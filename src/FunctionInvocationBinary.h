@@ -96,6 +96,8 @@ private:
 
 	static bool safe_ops(eBinaryOps op);
 
+	bool output_canonical(std::ostream &out) const;
+
 	// unimplemented
 	FunctionInvocationBinary &operator=(const FunctionInvocationBinary &fi);
 
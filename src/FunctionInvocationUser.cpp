@@ -66,13 +66,16 @@
 #include "Fact.h"
 #include "SafeOpFlags.h"
 #include "Error.h"
+#include "CGOptions.h"
+#include "CallGraph.h"
+#include "CallSummaryCache.h"
 
 using namespace std;
 
-static vector<bool> needcomma;  // Flag to track output of commas
+static thread_local vector<bool> needcomma;  // Flag to track output of commas
 
-static vector<const FunctionInvocationUser*> invocations;   // list of function calls
-static vector<const Fact*> return_facts;              // list of return facts
+static thread_local vector<const FunctionInvocationUser*> invocations;   // list of function calls
+static thread_local vector<const Fact*> return_facts;              // list of return facts
 
 const Fact*
 get_return_fact_for_invocation(const FunctionInvocationUser* fiu, const Variable* var, enum eFactCategory cat)
@@ -120,8 +123,8 @@ calls_to_funcs(const vector<const FunctionInvocationUser*>& calls, vector<const
 }
 
 /*
- * find the functions from a list of function calls. If this is a new function, find the invocations
- * inside it recursively
+ * find the functions from a list of function calls. If this is a new function, add the
+ * functions it reaches in the call graph
  */
 void
 calls_to_funcs_recursive(const vector<const FunctionInvocationUser*>& calls, vector<const Function*>& funcs)
@@ -131,10 +134,7 @@ calls_to_funcs_recursive(const vector<const FunctionInvocationUser*>& calls, vec
 		const Function* func = calls[i]->get_func();
 		if (find_function_in_set(funcs, func) == -1) {
 			funcs.push_back(func);
-			// find the calls made this function and add callees recursively
-			vector<const FunctionInvocationUser*> calls;
-			func->body->get_called_funcs(calls);
-			calls_to_funcs_recursive(calls, funcs);
+			CallGraph::get_reachable(func, funcs);
 		}
 	}
 }
@@ -189,6 +189,7 @@ FunctionInvocationUser::build_invocation_and_function(CGContext &cg_context, con
 	FactMgr* caller_fm = get_fact_mgr(&cg_context);
 	Effect running_eff_context(cg_context.get_effect_context());
 	Function* func = Function::make_random_signature(cg_context, type, qfer);
+	ERROR_GUARD(NULL);
 
 	if (func->name == "func_51")
 		BREAK_NOP;		// for debugging
@@ -200,6 +201,7 @@ FunctionInvocationUser::build_invocation_and_function(CGContext &cg_context, con
 		Variable* v = func->param[i];
 		// to avoid too much function invocations as parameters
 		Expression *p = Expression::make_random_param(param_cg_context, v->type, &v->qfer);
+		ERROR_GUARD(NULL);
 		// typecast, if needed.
 		p->check_and_set_cast(v->type);
 		param_values.push_back(p);
@@ -220,9 +222,10 @@ FunctionInvocationUser::build_invocation_and_function(CGContext &cg_context, con
 	// create function body
 	Effect effect_accum;
 	func->generate_body_with_known_params(cg_context, effect_accum);
+	ERROR_GUARD_AND_DEL1(NULL, fiu);
 
 	// post creation processing
-	FactVec ret_facts = fm->map_facts_out[func->body];
+	FactVec ret_facts = fm->map_facts_out.get(func->body);
 	func->body->add_back_return_facts(fm, ret_facts);
 	fiu->save_return_fact(ret_facts);
 
@@ -248,6 +251,7 @@ FunctionInvocationUser::build_invocation_and_function(CGContext &cg_context, con
 	}
 
 	func->visited_cnt = 1;
+	func->stream_output();
 	return fiu;
 }
 
@@ -337,21 +341,38 @@ FunctionInvocationUser::revisit(std::vector<const Fact*>& inputs, CGContext& cg_
 	// add facts related to pass parameters
 	fm->caller_to_callee_handover(this, inputs);
 
-	map<const Statement*, FactVec> facts_in_copy = fm->map_facts_in;
-	map<const Statement*, FactVec> facts_out_copy = fm->map_facts_out;
-	map<const Statement*, Effect>  stm_effect_copy = fm->map_stm_effect;
-	map<const Statement*, Effect>  accum_effect_copy = fm->map_accum_effect;
+	// an earlier call with the same inputs tells the outcome
+	bool use_summary = CGOptions::callee_summaries() && cg_context.get_effect_accum() &&
+		cg_context.get_effect_accum()->is_empty();
+	FactVec callee_facts;
+	if (use_summary) {
+		const CallSummary *summary = CallSummaryCache::find(func, inputs_copy, inputs, cg_context);
+		if (summary) {
+			inputs = summary->ok ? summary->facts_out : inputs_copy;
+			if (summary->ok) {
+				cg_context.reset_effect_accum(summary->effect);
+				save_return_fact(summary->ret_facts);
+				func->accum_eff_context.add_external_effect(cg_context.get_effect_context());
+			}
+			return summary->ok;
+		}
+		callee_facts = inputs;
+	}
+
+	fm->checkpoint();
 	// TODO: revisit only if "contingent variable" has been changed?
 	if (!func->body->visit_facts(inputs, cg_context)) {
 		// restore facts and effect
-		fm->map_facts_in = facts_in_copy;
-		fm->map_facts_out = facts_out_copy;
-		fm->map_stm_effect = stm_effect_copy;
-		fm->map_accum_effect = accum_effect_copy;
+		fm->rollback();
+		if (use_summary) {
+			CallSummaryCache::add(func, inputs_copy, callee_facts, cg_context, false,
+								  FactVec(), FactVec(), Effect());
+		}
 		inputs = inputs_copy;
 		return false;
 	}
-	cg_context.add_effect(fm->map_stm_effect[func->body]);
+	fm->commit();
+	cg_context.add_effect(fm->map_stm_effect.get(func->body));
 	FactVec ret_facts;
 	func->body->add_back_return_facts(fm, ret_facts);
 	save_return_fact(ret_facts);
@@ -365,8 +386,15 @@ FunctionInvocationUser::revisit(std::vector<const Fact*>& inputs, CGContext& cg_
 	// remember the effect context during this visit to this function
 	func->accum_eff_context.add_external_effect(cg_context.get_effect_context());
 	// update the original facts with new facts changed by function call
+	FactVec caller_facts;
+	if (use_summary)
+		caller_facts = inputs_copy;
 	renew_facts(inputs_copy, inputs);
 	inputs = inputs_copy;
+	if (use_summary) {
+		CallSummaryCache::add(func, caller_facts, callee_facts, cg_context, true,
+							  inputs, ret_facts, *cg_context.get_effect_accum());
+	}
 	return true;
 }
 
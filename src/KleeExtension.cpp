@@ -65,7 +65,7 @@ KleeExtension::output_symbolics(ostream &out)
 		assert(*i);
 		out << AbsExtension::tab_;
 		out << "klee_make_symbolic(&" << (*i)->get_name() << ", sizeof(" << (*i)->get_name() << "), ";
-		out << "\"" << KleeExtension::input_base_name_ << count << "\");" << endl;
+		out << "\"" << KleeExtension::input_base_name_ << count << "\");" << '\n';
 		count++;
 	}
 }
@@ -73,8 +73,8 @@ KleeExtension::output_symbolics(ostream &out)
 void
 KleeExtension::OutputInit(std::ostream &out)
 {
-	out << "int main(void)" << endl;
-	out << "{" << endl;
+	out << "int main(void)" << '\n';
+	out << "{" << '\n';
 	AbsExtension::default_output_definitions(out, values_, false);
 	output_symbolics(out);
 }
@@ -82,13 +82,13 @@ KleeExtension::OutputInit(std::ostream &out)
 void
 KleeExtension::OutputHeader(std::ostream &out)
 {
-	out << "#include \"klee/klee.h\"" << endl;
+	out << "#include \"klee/klee.h\"" << '\n';
 }
 
 void
 KleeExtension::OutputTail(std::ostream &out)
 {
-	out << AbsExtension::tab_ << "return 0;" << endl;
+	out << AbsExtension::tab_ << "return 0;" << '\n';
 }
 
 void
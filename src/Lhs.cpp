@@ -76,6 +76,7 @@ Lhs::make_random(CGContext &cg_context, const Type* t, const CVQualifiers* qfer,
 		var = VariableSelector::select_must_use_var(Effect::WRITE, cg_context, t, qfer);
 		if (var == NULL) {
 			bool flag = rnd_flipcoin(SelectDerefPointerProb);
+			ERROR_GUARD(NULL);
 			if (flag) {
 				var = VariableSelector::select_deref_pointer(Effect::WRITE, cg_context, t, qfer, dummy);
 				ERROR_GUARD(NULL);
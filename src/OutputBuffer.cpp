@@ -0,0 +1,106 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "OutputBuffer.h"
+
+
+// the buffer starts at this size and doubles as needed
+static const size_t initial_size = 64 * 1024;
+
+// past this size, the text is written out in chunks
+static const size_t max_size = 16 * 1024 * 1024;
+
+OutputBuffer::OutputBuffer(std::ostream &target)
+	: target_(target),
+	  buf_(initial_size)
+{
+	reset_put_area(0);
+}
+
+OutputBuffer::~OutputBuffer()
+{
+	write_out();
+}
+
+void
+OutputBuffer::reset_put_area(size_t used)
+{
+	setp(&buf_[0], &buf_[0] + buf_.size());
+	pbump(static_cast<int>(used));
+}
+
+/*
+ * Write all the text collected so far to the target
+ */
+void
+OutputBuffer::write_out(void)
+{
+	size_t used = pptr() - pbase();
+	if (used > 0) {
+		target_.write(pbase(), used);
+		reset_put_area(0);
+	}
+	target_.flush();
+}
+
+OutputBuffer::int_type
+OutputBuffer::overflow(int_type c)
+{
+	size_t used = pptr() - pbase();
+	if (buf_.size() >= max_size) {
+		write_out();
+	}
+	else {
+		buf_.resize(buf_.size() * 2);
+		reset_put_area(used);
+	}
+	if (!traits_type::eq_int_type(c, traits_type::eof())) {
+		*pptr() = traits_type::to_char_type(c);
+		pbump(1);
+	}
+	return traits_type::not_eof(c);
+}
+
+int
+OutputBuffer::sync(void)
+{
+	// the text goes out in write_out only
+	return 0;
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -49,6 +49,8 @@
 #include "git_version.h"
 #include "random.h"
 #include "util.h"
+#include "Profiler.h"
+#include "Budget.h"
 
 const char *OutputMgr::hash_func_name = "csmith_compute_hash";
 
@@ -73,7 +75,9 @@ using namespace std;
 
 vector<string> OutputMgr::monitored_funcs_;
 
-std::string OutputMgr::curr_func_ = "";
+thread_local std::string OutputMgr::curr_func_ = "";
+
+thread_local bool OutputMgr::canonical_ = false;
 
 void
 OutputMgr::set_curr_func(const std::string &fname)
@@ -110,7 +114,7 @@ OutputMgr::OutputMain(std::ostream &out)
 
 	FunctionInvocation *invoke = NULL;
 	invoke = ExtensionMgr::MakeFuncInvocation(GetFirstFunction(), cg_context);
-	out << endl << endl;
+	out << '\n' << '\n';
 	output_comment_line(out, "----------------------------------------");
 
 	ExtensionMgr::OutputInit(out);
@@ -127,14 +131,14 @@ OutputMgr::OutputMain(std::ostream &out)
 	}
 	else {
 		// set up a global variable that controls if we print the hash value after computing it for each global
-		out << "    int print_hash_value = 0;" << endl;
+		out << "    int print_hash_value = 0;" << '\n';
 		if (CGOptions::accept_argc()) {
-			out << "    if (argc == 2 && strcmp(argv[1], \"1\") == 0) print_hash_value = 1;" << endl;
+			out << "    if (argc == 2 && strcmp(argv[1], \"1\") == 0) print_hash_value = 1;" << '\n';
 		}
 
-		out << "    platform_main_begin();" << endl;
+		out << "    platform_main_begin();" << '\n';
 		if (CGOptions::compute_hash()) {
-			out << "    crc32_gentab();" << endl;
+			out << "    crc32_gentab();" << '\n';
 		}
 
 		ExtensionMgr::OutputFirstFunInvocation(out, invoke);
@@ -142,7 +146,7 @@ OutputMgr::OutputMain(std::ostream &out)
 	#if 0
 		out << "    ";
 		invoke->Output(out);
-		out << ";" << endl;
+		out << ";" << '\n';
 	#endif
 		// resetting all global dangling pointer to null per Rohit's request
 		if (!CGOptions::dangling_global_ptrs()) {
@@ -154,13 +158,13 @@ OutputMgr::OutputMain(std::ostream &out)
 		else
 			HashGlobalVariables(out);
 		if (CGOptions::compute_hash()) {
-			out << "    platform_main_end(crc32_context ^ 0xFFFFFFFFUL, print_hash_value);" << endl;
+			out << "    platform_main_end(crc32_context ^ 0xFFFFFFFFUL, print_hash_value);" << '\n';
 		} else {
-			out << "    platform_main_end(0,0);" << endl;
+			out << "    platform_main_end(0,0);" << '\n';
 		}
 	}
 	ExtensionMgr::OutputTail(out);
-	out << "}" << endl;
+	out << "}" << '\n';
 	delete invoke;
 }
 
@@ -168,7 +172,7 @@ void
 OutputMgr::OutputHashFuncInvocation(std::ostream &out, int indent)
 {
 	OutputMgr::output_tab_(out, indent);
-	out << OutputMgr::hash_func_name << "();" << std::endl;
+	out << OutputMgr::hash_func_name << "();" << '\n';
 }
 
 void
@@ -176,58 +180,58 @@ OutputMgr::OutputStepHashFuncInvocation(std::ostream &out, int indent, int stmt_
 {
 	if (is_monitored_func()) {
 		OutputMgr::output_tab_(out, indent);
-		out << OutputMgr::step_hash_func_name << "(" << stmt_id << ");" << std::endl;
+		out << OutputMgr::step_hash_func_name << "(" << stmt_id << ");" << '\n';
 	}
 }
 
 void
 OutputMgr::OutputStepHashFuncDef(std::ostream &out)
 {
-	out << std::endl;
-	out << "void " << OutputMgr::step_hash_func_name << "(int stmt_id)" << std::endl;
-	out << "{" << std::endl;
+	out << '\n';
+	out << "void " << OutputMgr::step_hash_func_name << "(int stmt_id)" << '\n';
+	out << "{" << '\n';
 
 	int indent = 1;
 	OutputMgr::output_tab_(out, indent);
-	out << "int i = 0;" << std::endl;
+	out << "int i = 0;" << '\n';
 	OutputMgr::OutputHashFuncInvocation(out, indent);
 	OutputMgr::output_tab_(out, indent);
 	out << "printf(\"before stmt(%d): ";
-	out << "checksum = %X\\n\", stmt_id, crc32_context ^ 0xFFFFFFFFUL);" << std::endl;
+	out << "checksum = %X\\n\", stmt_id, crc32_context ^ 0xFFFFFFFFUL);" << '\n';
 
 	OutputMgr::output_tab_(out, indent);
-	out << "crc32_context = 0xFFFFFFFFUL; " << std::endl;
+	out << "crc32_context = 0xFFFFFFFFUL; " << '\n';
 
 	OutputMgr::output_tab_(out, indent);
-	out << "for (i = 0; i < 256; i++) { " << std::endl;
+	out << "for (i = 0; i < 256; i++) { " << '\n';
 	OutputMgr::output_tab_(out, indent+1);
-	out << "crc32_tab[i] = 0;" << std::endl;
+	out << "crc32_tab[i] = 0;" << '\n';
 	OutputMgr::output_tab_(out, indent);
-	out << "}" << std::endl;
+	out << "}" << '\n';
 	OutputMgr::output_tab_(out, indent);
-	out << "crc32_gentab();" << endl;
-	out << "}" << std::endl;
+	out << "crc32_gentab();" << '\n';
+	out << "}" << '\n';
 }
 
 void
 OutputMgr::OutputHashFuncDecl(std::ostream &out)
 {
 	out << "void " << OutputMgr::hash_func_name << "(void);";
-	out << std::endl << std::endl;
+	out << '\n' << '\n';
 }
 
 void
 OutputMgr::OutputStepHashFuncDecl(std::ostream &out)
 {
 	out << "void " << OutputMgr::step_hash_func_name << "(int stmt_id);";
-	out << std::endl << std::endl;
+	out << '\n' << '\n';
 }
 
 void
 OutputMgr::OutputHashFuncDef(std::ostream &out)
 {
-	out << "void " << OutputMgr::hash_func_name << "(void)" << std::endl;
-	out << "{" << std::endl;
+	out << "void " << OutputMgr::hash_func_name << "(void)" << '\n';
+	out << "{" << '\n';
 
 	size_t dimen = Variable::GetMaxArrayDimension(*VariableSelector::GetGlobalVariables());
 	if (dimen) {
@@ -235,17 +239,22 @@ OutputMgr::OutputHashFuncDef(std::ostream &out)
 		OutputArrayCtrlVars(ctrl_vars, out, dimen, 1);
 	}
 	HashGlobalVariables(out);
-	out << "}" << std::endl;
+	out << "}" << '\n';
 }
 
 void
 OutputMgr::OutputTail(std::ostream &out)
 {
+	Budget::OutputBudget(out);
 	if (!CGOptions::concise()) {
-		out << endl << "/************************ statistics *************************" << endl;
+		out << '\n' << "/************************ statistics *************************" << '\n';
 		Bookkeeper::output_statistics(out);
-		out << "********************* end of statistics **********************/" << endl;
-		out << endl;
+		out << "********************* end of statistics **********************/" << '\n';
+		out << '\n';
+	}
+	if (CGOptions::profile()) {
+		Profiler::OutputProfile(out);
+		out << '\n';
 	}
 }
 
@@ -262,14 +271,14 @@ OutputMgr::OutputHeader(int argc, char *argv[], unsigned long seed)
 				out << " " << argv[i];
 			}
 		}
-		out << endl;
+		out << '\n';
 	}
 	else {
-		out << "/*" << endl;
-		out << " * This is a RANDOMLY GENERATED PROGRAM." << endl;
-		out << " *" << endl;
-		out << " * Generator: " << PACKAGE_STRING << endl;
-		out << " * Git version: " << git_version << endl;
+		out << "/*" << '\n';
+		out << " * This is a RANDOMLY GENERATED PROGRAM." << '\n';
+		out << " *" << '\n';
+		out << " * Generator: " << PACKAGE_STRING << '\n';
+		out << " * Git version: " << git_version << '\n';
 		out << " * Options:  ";
 		if (argc <= 1) {
 			out << " (none)";
@@ -278,16 +287,24 @@ OutputMgr::OutputHeader(int argc, char *argv[], unsigned long seed)
 				out << " " << argv[i];
 			}
 		}
-		out << endl;
-		out << " * Seed:      " << seed << endl;
-		out << " */" << endl;
-		out << endl;
+		out << '\n';
+		out << " * Seed:      " << seed << '\n';
+		out << " */" << '\n';
+		out << '\n';
 	}
 
 	if (!CGOptions::longlong()) {
-		out << endl;
-		out << "#define NO_LONGLONG" << std::endl;
-		out << endl;
+		out << '\n';
+		out << "#define NO_LONGLONG" << '\n';
+		out << '\n';
+	}
+	if (CGOptions::fast_crc() && CGOptions::compute_hash()) {
+		out << "#define CSMITH_FAST_CRC" << '\n';
+		out << '\n';
+	}
+	if (CGOptions::block_hash() && CGOptions::compute_hash()) {
+		out << "#define CSMITH_BLOCK_HASH" << '\n';
+		out << '\n';
 	}
 	if (CGOptions::enable_float()) {
 		out << "#include <float.h>\n";
@@ -296,33 +313,33 @@ OutputMgr::OutputHeader(int argc, char *argv[], unsigned long seed)
 
 	ExtensionMgr::OutputHeader(out);
 
-	out << runtime_include << endl;
+	out << runtime_include << '\n';
 
  	if (!CGOptions::compute_hash()) {
 		if (CGOptions::allow_int64())
-			out << "volatile uint64_t " << Variable::sink_var_name << " = 0;" << endl;
+			out << "volatile uint64_t " << Variable::sink_var_name << " = 0;" << '\n';
 		else
-			out << "volatile uint32_t " << Variable::sink_var_name << " = 0;" << endl;
+			out << "volatile uint32_t " << Variable::sink_var_name << " = 0;" << '\n';
 	}
-	out << endl;
+	out << '\n';
 
-	out << "static long __undefined;" << endl;
-	out << endl;
+	out << "static long __undefined;" << '\n';
+	out << '\n';
 
 	if (CGOptions::depth_protect()) {
-		out << "#define MAX_DEPTH (5)" << endl;
+		out << "#define MAX_DEPTH (5)" << '\n';
 		// Make depth signed, to cover our tails.
-		out << "int32_t DEPTH = 0;" << endl;
-		out << endl;
+		out << "int32_t DEPTH = 0;" << '\n';
+		out << '\n';
 	}
 
 	// out << platform_include << endl;
 	if (CGOptions::wrap_volatiles()) {
-		out << volatile_include << endl;
+		out << volatile_include << '\n';
 	}
 
 	if (CGOptions::access_once()) {
-		out << access_once_macro << endl;
+		out << access_once_macro << '\n';
 	}
 
 	if (CGOptions::step_hash_by_stmt()) {
@@ -370,9 +387,19 @@ OutputMgr::OutputPtrResets(ostream &out, const vector<const Variable*>& ptrs)
 void
 OutputMgr::output_tab_(ostream &out, int indent)
 {
-	while (indent--) {
-		out << TAB;
+	// the indentation of the deepest blocks, written in one piece
+	static const std::string tabs = [] {
+		std::string s;
+		for (int i = 0; i < 32; i++)
+			s += TAB;
+		return s;
+	}();
+	const int tab_len = sizeof(TAB) - 1;
+	for (; indent > 32; indent -= 32) {
+		out << tabs;
 	}
+	if (indent > 0)
+		out.write(tabs.data(), indent * tab_len);
 }
 
 void
@@ -384,7 +411,7 @@ OutputMgr::output_tab(ostream &out, int indent)
 void
 OutputMgr::really_outputln(ostream &out)
 {
-	out << std::endl;
+	out << '\n';
 }
 
 //////////////////////////////////////////////////////////////////
@@ -36,6 +36,7 @@
 using namespace std;
 
 class Variable;
+class Function;
 
 #define TAB "    "    // to beautify output: 1 tab is 4 spaces
 
@@ -61,10 +62,21 @@ public:
 
 	static void set_curr_func(const std::string &fname);
 
+	// print programs in a canonical form to compare them, see DFSDuplicateChecker
+	static bool canonical_output(void) { return canonical_; }
+
+	static void set_canonical_output(bool canonical) { canonical_ = canonical; }
+
 	virtual void OutputHeader(int argc, char *argv[], unsigned long seed) = 0;
 
 	virtual void OutputStructUnions(ostream& /* out */) {};
 
+	// for --stream-output: called once the types are generated, and then
+	// each time a function is complete
+	virtual void OutputTypes() {};
+
+	virtual void OutputFinishedFunction(Function * /* f */) {};
+
 	virtual void Output() = 0;
 
 	virtual void outputln(ostream &out) {out << std::endl;}
@@ -94,7 +106,9 @@ private:
 
 	static bool is_monitored_func(void);
 
-	static std::string curr_func_;
+	static thread_local std::string curr_func_;
+
+	static thread_local bool canonical_;
 
 };
 
@@ -0,0 +1,128 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "PackedSequence.h"
+
+#include <cassert>
+
+using namespace std;
+
+const char PackedSequence::default_sep_char = '_';
+
+PackedSequence::PackedSequence(const char sep_char)
+	: sep_char_(sep_char)
+{
+	// Nothing to do
+}
+
+PackedSequence::~PackedSequence()
+{
+	// Nothing to do
+}
+
+void
+PackedSequence::init_sequence()
+{
+
+}
+
+void
+PackedSequence::add_number(int v, int /*bound*/, int k)
+{
+	assert(k >= 0);
+	if (static_cast<size_t>(k) >= seq_.size())
+		seq_.resize(k + 1, 0);
+	if (v >= 0 && v < large_mark) {
+		if (seq_[k] == large_mark)
+			large_.erase(k);
+		seq_[k] = static_cast<unsigned char>(v);
+	}
+	else {
+		seq_[k] = large_mark;
+		large_[k] = v;
+	}
+}
+
+int
+PackedSequence::get_number(int /*bound*/)
+{
+	return -1;
+}
+
+int
+PackedSequence::get_number_by_pos(int pos)
+{
+	assert(pos >= 0);
+	if (static_cast<size_t>(pos) >= seq_.size())
+		seq_.resize(pos + 1, 0);
+	int rv = (seq_[pos] == large_mark) ? large_[pos] : seq_[pos];
+	assert(rv >= 0);
+	return rv;
+}
+
+void
+PackedSequence::clear()
+{
+	seq_.clear();
+	large_.clear();
+}
+
+void
+PackedSequence::get_sequence(ostream &ss)
+{
+	assert(!seq_.empty());
+
+	for (size_t i = 0; i < seq_.size(); ++i) {
+		if (i > 0)
+			ss << sep_char_;
+		if (seq_[i] == large_mark)
+			ss << large_[i];
+		else
+			ss << static_cast<int>(seq_[i]);
+	}
+}
+
+unsigned INT64
+PackedSequence::sequence_length()
+{
+	return seq_.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,85 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef PACKED_SEQUENCE_H
+#define PACKED_SEQUENCE_H
+
+#include <map>
+#include <vector>
+
+#include "Sequence.h"
+
+/*
+ * A sequence kept in a vector indexed by position, one byte per number.
+ * Numbers that do not fit in a byte are kept aside in large_. Positions that
+ * were never set read as 0, like they do in LinearSequence.
+ */
+class PackedSequence : public Sequence {
+public:
+	explicit PackedSequence(const char sep_char);
+
+	virtual ~PackedSequence();
+
+	virtual void init_sequence();
+
+	virtual unsigned INT64 sequence_length();
+
+	virtual void add_number(int v, int bound, int k);
+
+	virtual int get_number(int bound);
+
+	virtual int get_number_by_pos(int pos);
+
+	virtual void clear();
+
+	virtual void get_sequence(std::ostream &);
+
+	virtual char get_sep_char() const { return sep_char_; }
+
+	static const char default_sep_char;
+
+private:
+	// marks a number kept in large_
+	static const unsigned char large_mark = 0xFF;
+
+	std::vector<unsigned char> seq_;
+
+	std::map<int, int> large_;
+
+	const char sep_char_;
+};
+
+#endif // PACKED_SEQUENCE_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
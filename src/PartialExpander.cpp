@@ -37,7 +37,7 @@
 
 using namespace std;
 
-std::map<eStatementType, bool> PartialExpander::expands_;
+thread_local std::map<eStatementType, bool> PartialExpander::expands_;
 
 std::map<eStatementType, bool> PartialExpander::expands_backup_;
 
@@ -59,7 +59,8 @@ private:
 
 	static bool parse_options(const std::string &options, char sep_char);
 
-	static std::map<eStatementType, bool> expands_;
+	// changed while generating, per thread
+	static thread_local std::map<eStatementType, bool> expands_;
 
 	static std::map<eStatementType, bool> expands_backup_;
 };
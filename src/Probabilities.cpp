@@ -361,7 +361,7 @@ GroupProbElem::dump_val(std::ostream &out)
 
 /////////////////////////////////////////////////////////////////
 
-Probabilities* Probabilities::instance_ = NULL;
+thread_local Probabilities* Probabilities::instance_ = NULL;
 
 Probabilities *
 Probabilities::GetInstance()
@@ -1151,6 +1151,7 @@ void DistributionTable::add_entry(int key, int prob)
 	keys_.push_back(key);
 	probs_.push_back(prob);
 	max_prob_ += prob;
+	bounds_.push_back(max_prob_);
 }
 
 int DistributionTable::key_to_prob(int key) const
@@ -1167,14 +1168,10 @@ int DistributionTable::key_to_prob(int key) const
 int DistributionTable::rnd_num_to_key(int rnd) const
 {
 	assert(rnd < max_prob_ && rnd >= 0);
-	assert(keys_.size() == probs_.size());
-	for (size_t i=0; i<probs_.size(); i++) {
-		if (rnd < probs_[i]) {
-			return keys_[i];
-		}
-		rnd -= probs_[i];
-	}
-	assert(0);
-	return -1;
+	assert(keys_.size() == bounds_.size());
+	// the first entry whose range ends after rnd, skipping those with 0 probability
+	vector<int>::const_iterator i = std::upper_bound(bounds_.begin(), bounds_.end(), rnd);
+	assert(i != bounds_.end());
+	return keys_[i - bounds_.begin()];
 }
 
@@ -41,24 +41,13 @@
 
 using namespace std;
 
-template <class Key, class Value>
-class TableEntry {
-public:
-	TableEntry(Key k, Value v);
-
-	Key get_key() { return key_; }
-
-	Value get_value() { return value_; }
-
-private:
-	Key key_;
-	Value value_;
-};
-
+/*
+ * Maps a random number to a value: each value owns the numbers from the
+ * previous key up to (but excluding) its own key. The keys are kept sorted
+ * in one array, so a lookup is a binary search.
+ */
 template <class Key, class Value>
 class ProbabilityTable {
-	typedef TableEntry<Key, Value> Entry;
-
 public:
 	ProbabilityTable();
 
@@ -68,36 +57,23 @@ public:
 
 	void add_elem(Key k, Value v);
 
-	void sorted_insert(Entry *t);
-
 	Value get_value(Key k);
 
 private:
 	Key curr_max_key_;
-	std::vector<Entry *> table_;
+	std::vector<Key> keys_;
+	std::vector<Value> values_;
 };
 
-template <class Key, class Value>
-TableEntry<Key, Value>::TableEntry(Key k, Value v)
-	: key_(k),
-	  value_(v)
-{
-}
-
 template <class Key, class Value>
 ProbabilityTable<Key, Value>::ProbabilityTable()
 	: curr_max_key_(0)
 {
-	table_.clear();
 }
 
 template <class Key, class Value>
 ProbabilityTable<Key, Value>::~ProbabilityTable()
 {
-	typename vector<Entry *>::iterator i;
-	for (i = table_.begin(); i != table_.end(); ++i)
-		delete (*i);
-	table_.clear();
 }
 
 template <class Key, class Value>
@@ -107,57 +83,16 @@ void ProbabilityTable<Key, Value>::initialize(ProbName pname)
 	impl_->set_prob_table(this, pname);
 }
 
-template <class Key, class Value>
-bool my_less(TableEntry<Key, Value> *t, Key k2)
-{
-	Key k1 = t->get_key();
-	return (k1 < k2);
-}
-
-template <class Key, class Value>
-bool my_greater(TableEntry<Key, Value> *t, Key k2)
-{
-	Key k1 = t->get_key();
-	return (k1 > k2);
-}
-
-template <class Key, class Value>
-void
-ProbabilityTable<Key, Value>::sorted_insert(Entry *t)
-{
-	assert(t);
-
-	Key k = t->get_key();
-
-	if (table_.empty()) {
-		table_.push_back(t);
-		curr_max_key_ = k;
-		return;
-	}
-
-	typename vector<Entry *>::iterator i;
-	for (i=table_.begin(); i!=table_.end(); i++) {
-		if (my_greater<Key, Value>(*i, k)) {
-			break;
-		}
-	}
-	//i = find_if(table_.begin(), table_.end(), std::bind2nd(std::ptr_fun(my_greater<Key, Value>), k));
-
-	if (i != table_.end()) {
-		table_.insert(i, t);
-	}
-	else {
-		table_.push_back(t);
-		curr_max_key_ = k;
-	}
-}
-
 template <class Key, class Value>
 void
 ProbabilityTable<Key, Value>::add_elem(Key k, Value v)
 {
-	Entry *t = new Entry(k, v);
-	sorted_insert(t);
+	// after the entries with the same key, like a stable sort
+	typename vector<Key>::iterator i = std::upper_bound(keys_.begin(), keys_.end(), k);
+	size_t pos = i - keys_.begin();
+	keys_.insert(i, k);
+	values_.insert(values_.begin() + pos, v);
+	curr_max_key_ = keys_.back();
 }
 
 template <class Key, class Value>
@@ -166,11 +101,11 @@ ProbabilityTable<Key, Value>::get_value(Key k)
 {
 	assert(k < curr_max_key_);
 
-	typename vector<Entry *>::iterator i;
-	i = find_if(table_.begin(), table_.end(), std::bind2nd(std::ptr_fun(my_greater<Key, Value>), k));
+	// the first entry whose key is greater than k
+	typename vector<Key>::const_iterator i = std::upper_bound(keys_.begin(), keys_.end(), k);
 
-	assert(i != table_.end());
-	return (*i)->get_value();
+	assert(i != keys_.end());
+	return values_[i - keys_.begin()];
 }
 
 class DistributionTable {
@@ -179,6 +114,7 @@ public:
 	~DistributionTable() {};
 
 	void add_entry(int key, int prob);
+	void clear(void) { max_prob_ = 0; keys_.clear(); probs_.clear(); bounds_.clear(); }
 	int get_max(void) const { return max_prob_;}
 	int key_to_prob(int key) const;
 	int rnd_num_to_key(int rnd) const;
@@ -186,6 +122,8 @@ private:
 	int max_prob_;
 	vector<int> keys_;
 	vector<int> probs_;
+	// running sums of probs_, for binary search in rnd_num_to_key
+	vector<int> bounds_;
 };
 
 #endif
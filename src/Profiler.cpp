@@ -0,0 +1,154 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "Profiler.h"
+#include <chrono>
+#include <iomanip>
+
+using namespace std;
+
+static const char *phase_names[Profiler::MAX_PHASE] = {
+	"types",
+	"generate_body",
+	"find_fixed_point",
+	"select_variable",
+	"function_invocation",
+	"depth_backtracking",
+	"output",
+};
+
+thread_local double Profiler::start_time = 0;
+thread_local double Profiler::phase_start[MAX_PHASE];
+thread_local double Profiler::phase_time[MAX_PHASE];
+thread_local int Profiler::phase_depth[MAX_PHASE];
+thread_local unsigned long Profiler::phase_calls[MAX_PHASE];
+thread_local unsigned long Profiler::fact_merge_cnt = 0;
+thread_local unsigned long Profiler::fact_join_cnt = 0;
+thread_local unsigned long Profiler::backtrack_cnt = 0;
+thread_local int Profiler::max_fixed_point_rounds = 0;
+
+/*
+ * seconds since an arbitrary point
+ */
+double
+Profiler::now(void)
+{
+	return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void
+Profiler::start(void)
+{
+	start_time = now();
+}
+
+void
+Profiler::enter(Phase p)
+{
+	phase_calls[p]++;
+	if (phase_depth[p]++ == 0) {
+		phase_start[p] = now();
+	}
+}
+
+void
+Profiler::leave(Phase p)
+{
+	if (--phase_depth[p] == 0) {
+		phase_time[p] += now() - phase_start[p];
+	}
+}
+
+void
+Profiler::count_fixed_point(int rounds)
+{
+	if (rounds > max_fixed_point_rounds) {
+		max_fixed_point_rounds = rounds;
+	}
+}
+
+/*
+ * Output the profile as a JSON object in a comment. Phases still running
+ * (the output phase, when called from the output tail) are counted up to now.
+ */
+void
+Profiler::OutputProfile(std::ostream &out)
+{
+	double t = now();
+	out << "/************************ profile *************************" << '\n';
+	out << "{" << '\n';
+	out << fixed << setprecision(3);
+	out << "  \"total_ms\": " << (t - start_time) * 1000 << "," << '\n';
+	out << "  \"phases\": {" << '\n';
+	for (int i = 0; i < MAX_PHASE; i++) {
+		double time = phase_time[i];
+		if (phase_depth[i] > 0) {
+			time += t - phase_start[i];
+		}
+		out << "    \"" << phase_names[i] << "\": { \"calls\": " << phase_calls[i]
+			<< ", \"ms\": " << time * 1000 << " }";
+		out << (i + 1 < MAX_PHASE ? "," : "") << '\n';
+	}
+	out << "  }," << '\n';
+	out << "  \"fact_merges\": " << fact_merge_cnt << "," << '\n';
+	out << "  \"fact_joins\": " << fact_join_cnt << "," << '\n';
+	out << "  \"depth_backtracks\": " << backtrack_cnt << "," << '\n';
+	out << "  \"max_fixed_point_rounds\": " << max_fixed_point_rounds << '\n';
+	out << "}" << '\n';
+	out << "********************** end of profile ***********************/" << '\n';
+	out.unsetf(ios::floatfield);
+	out << setprecision(6);
+}
+
+void
+Profiler::doFinalization(void)
+{
+	for (int i = 0; i < MAX_PHASE; i++) {
+		phase_time[i] = 0;
+		phase_depth[i] = 0;
+		phase_calls[i] = 0;
+	}
+	fact_merge_cnt = 0;
+	fact_join_cnt = 0;
+	backtrack_cnt = 0;
+	max_fixed_point_rounds = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,136 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include <ostream>
+#include "CGOptions.h"
+
+/*
+ * Timing and call counts of the major generation phases, plus a few analysis
+ * counters, for --profile. Everything is per thread, so that batch workers
+ * profile their own programs.
+ *
+ * A phase is timed from its outermost entry only: GenerateBody and
+ * find_fixed_point recurse into themselves (through callees and nested
+ * blocks), and counting the nested time again would be meaningless. Phases
+ * do nest into each other, so the times of different phases overlap.
+ */
+class Profiler
+{
+public:
+	enum Phase {
+		pTypes,
+		pGenerateBody,
+		pFixedPoint,
+		pSelectVariable,
+		pInvocation,
+		pBacktracking,
+		pOutput,
+		MAX_PHASE
+	};
+
+	static void start(void);
+
+	static void enter(Phase p);
+
+	static void leave(Phase p);
+
+	static void count_fact_merge(void) { fact_merge_cnt++; }
+
+	static void count_fact_join(void) { fact_join_cnt++; }
+
+	static void count_backtrack(void) { backtrack_cnt++; }
+
+	static void count_fixed_point(int rounds);
+
+	static void OutputProfile(std::ostream &out);
+
+	static void doFinalization(void);
+
+private:
+	static double now(void);
+
+	static thread_local double start_time;
+
+	static thread_local double phase_start[MAX_PHASE];
+
+	static thread_local double phase_time[MAX_PHASE];
+
+	static thread_local int phase_depth[MAX_PHASE];
+
+	static thread_local unsigned long phase_calls[MAX_PHASE];
+
+	static thread_local unsigned long fact_merge_cnt;
+
+	static thread_local unsigned long fact_join_cnt;
+
+	static thread_local unsigned long backtrack_cnt;
+
+	static thread_local int max_fixed_point_rounds;
+
+	Profiler(void);
+	~Profiler(void);
+};
+
+/*
+ * Times the enclosing scope as one entry into a phase, if --profile is on.
+ */
+class ProfileScope
+{
+public:
+	explicit ProfileScope(Profiler::Phase p)
+		: phase(p), active(CGOptions::profile())
+	{
+		if (active)
+			Profiler::enter(phase);
+	}
+
+	~ProfileScope(void)
+	{
+		if (active)
+			Profiler::leave(phase);
+	}
+
+private:
+	Profiler::Phase phase;
+	bool active;
+};
+
+#endif // PROFILER_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -38,7 +38,7 @@
 #include "AbsRndNumGenerator.h"
 #include "Filter.h"
 
-RandomNumber *RandomNumber::instance_ = NULL;
+thread_local RandomNumber *RandomNumber::instance_ = NULL;
 
 RandomNumber::RandomNumber(const unsigned long seed)
 	: seed_(seed)
@@ -177,5 +177,6 @@ RandomNumber::doFinalization()
 		delete generator;
 	}
 	delete instance_;
+	instance_ = NULL;
 }
 
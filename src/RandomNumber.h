@@ -83,7 +83,7 @@ protected:
 
 	AbsRndNumGenerator *curr_generator_;
 
-	static RandomNumber *instance_;
+	static thread_local RandomNumber *instance_;
 
 	std::map<RNDNUM_GENERATOR, AbsRndNumGenerator*> generators_;
 
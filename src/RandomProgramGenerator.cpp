@@ -85,13 +85,21 @@ FUTURE:
 
 #include <ostream>
 #include <fstream>
+#include <sstream>
 #include <cstring>
 #include <cstdio>
+#include <map>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include "Common.h"
 
 #include "CGOptions.h"
 #include "AbsProgramGenerator.h"
+#include "DecisionTrace.h"
+#include "DefaultOutputMgr.h"
 
 #include "git_version.h"
 #include "platform.h"
@@ -109,6 +117,15 @@ using namespace std;
 // platforms.
 static unsigned long g_Seed = 0;
 
+// Batch mode: generate <g_Count> programs with consecutive seeds starting
+// from g_Seed in one process. Each program goes to its own file under
+// <g_BatchDir>, or to one stream of frames otherwise.
+static unsigned long g_Count = 0;
+static string g_BatchDir;
+
+// Number of threads generating the programs of batch mode.
+static unsigned long g_Jobs = 1;
+
 // ----------------------------------------------------------------------------
 static void
 print_version(void)
@@ -140,6 +157,33 @@ parse_int_arg(char *arg, unsigned long *ret)
 	return true;
 }
 
+static bool
+parse_seed_range_arg(char *arg, unsigned long *first, unsigned long *last)
+{
+	int res;
+	res = sscanf (arg, "%lu..%lu", first, last);
+
+	if (res != 2 || *first > *last) {
+		cout << "expected a seed range A..B with A <= B" << endl;
+		return false;
+	}
+	return true;
+}
+
+static bool
+parse_target_range_arg(char *arg, unsigned long *min, unsigned long *max)
+{
+	int res;
+	*max = 0;
+	res = sscanf (arg, "%lu:%lu", min, max);
+
+	if (res < 1 || (res == 2 && *min > *max)) {
+		cout << "expected a size range MIN:MAX with MIN <= MAX, or MIN: without a maximum" << endl;
+		return false;
+	}
+	return true;
+}
+
 static void print_help()
 {
 	cout << "Command line options: " << endl << endl;
@@ -149,12 +193,25 @@ static void print_help()
 	cout << "  --version or -v: print the version of Csmith." << endl << endl;
 	cout << "  --seed <seed> or -s <seed>: use <seed> instead of a random seed generated by Csmith." << endl << endl;
 	cout << "  --output <filename> or -o <filename>: specify the output file name." << endl << endl;
+	cout << "  --seeds <A>..<B>: generate one program for each seed from <A> to <B> in a single run." << endl << endl;
+	cout << "  --count <num>: generate <num> programs in a single run, with consecutive seeds starting from --seed." << endl << endl;
+	cout << "  --batch-dir <dir>: with --seeds or --count, write the program of seed <S> to <dir>/<S>.c. ";
+	cout << "Otherwise all programs are written to the output as frames, each a line \"/* csmith seed <S>: <N> bytes */\" ";
+	cout << "followed by the <N> bytes of the program." << endl << endl;
+	cout << "  --jobs <num> or -j <num>: with --seeds or --count, generate the programs with <num> threads. ";
+	cout << "With --dfs-exhaustive, split the search tree between <num> threads. ";
+	cout << "The output is the same as with one thread." << endl << endl;
 
 	// enabling/disabling options
 	cout << "  --argc | --no-argc: generate main function with/without argv and argc being passed (enabled by default)." << endl << endl;
 	cout << "  --arrays | --no-arrays: enable | disable arrays (enabled by default)." << endl << endl;
 	cout << "  --bitfields | --no-bitfields: enable | disable full-bitfields structs (enabled by default)." << endl << endl;
 	cout << "  --checksum | --no-checksum: enable | disable checksum calculation (enabled by default)." << endl << endl;
+	cout << "  --fast-crc | --no-fast-crc: let the generated program compute the checksum eight bytes at a time ";
+	cout << "(slicing-by-8) instead of byte by byte. The checksum values are the same (disabled by default)." << endl << endl;
+	cout << "  --block-hash | --no-block-hash: hash global arrays of integers, or of packed structs of one integer type, ";
+	cout << "with one runtime call each instead of a loop over the items. The checksum values are the same, but with ";
+	cout << "print_hash_value set there is one line per array (disabled by default)." << endl << endl;
 	cout << "  --comma-operators | --no-comma-operators: enable | disable comma operators (enabled by default)." << endl << endl;
 	cout << "  --compound-assignment | --no-compound-assignment: enable | disable compound assignments (enabled by default)." << endl << endl;
 	cout << "  --concise: generated programs with minimal comments (disabled by default)." << endl << endl;
@@ -229,6 +286,8 @@ static void print_advanced_help()
 	// file split options
 	cout << "  --max-split-files <num>: evenly split a generated program into <num> different files(default 0)." << endl << endl;
 	cout << "  --split-files-dir <dir>: generate split-files into <dir> (default ./output)." << endl << endl;
+	cout << "  --balance-split-files: with --max-split-files, spread the global variables and functions so that the files get ";
+	cout << "about the same amount of code, write the files in parallel and add a Makefile that builds them. Implies --no-force-globals-static (disabled by default)." << endl << endl;
 
 	// dfs-exhaustive mode options
 	cout << "  --dfs-exhaustive: enable depth first exhaustive random generation (disabled by default)." << endl << endl;
@@ -238,6 +297,10 @@ static void print_advanced_help()
 	cout << "  --compact-output: print generated programs in compact way. ";
 	cout << "Only works in the exhaustive mode." << endl << endl;
 
+	cout << "  --dfs-prune-duplicates: skip the parts of the search that can only lead to programs ";
+	cout << "enumerated already (up to names and the order of commutative operands), and report how much was pruned. ";
+	cout << "Only works in the exhaustive mode." << endl << endl;
+
 	cout << "  --max-nested-struct-level <num>: limit maximum nested level of structs to <num>(default 0). ";
 	cout << "Only works in the exhaustive mode." << endl << endl;
 
@@ -320,6 +383,22 @@ static void print_advanced_help()
 
 	cout << "  --stop-by-stmt <num>: try to stop generating statements after the statement with id <num>." << endl << endl;
 
+	cout << "  --budget-time <seconds>: stop creating new functions and statements after generating for <seconds>, ";
+	cout << "and finish the program as --stop-by-stmt does. The program then depends on the speed of the machine." << endl << endl;
+
+	cout << "  --budget-stmts <num>: stop creating new functions and statements after <num> statements (default 0, no limit)." << endl << endl;
+
+	cout << "  --budget-fact-iterations <num>: stop creating new functions and statements after <num> rounds of ";
+	cout << "the dataflow analysis over blocks (default 0, no limit)." << endl << endl;
+
+	cout << "  When a budget is reached, csmith says so on stderr and at the end of the program." << endl << endl;
+
+	cout << "  --target-size <min>:<max>: steer the generation toward a program of <min> to <max> bytes, ";
+	cout << "or of at least <min> bytes with <min>:. The size is estimated while generating, so the program ";
+	cout << "can still fall outside the range (default none)." << endl << endl;
+
+	cout << "  --target-stmts <min>:<max>: the same as --target-size, counting statements instead of bytes." << endl << endl;
+
 	cout << "  --const-as-condition: enable const to be conditions of if-statements. " << endl << endl;
 
 	cout << "  --match-exact-qualifiers: match exact const/volatile qualifiers for LHS and RHS of assignments." << endl << endl;
@@ -328,6 +407,35 @@ static void print_advanced_help()
 
 	cout << "  --return-dead-pointer | --no-return-dead-pointer: allow | disallow functions from returning dangling pointers (disallowed by default)." << endl << endl;
 
+	cout << "  --fixed-point-stats: report per function how many rounds the dataflow analysis took to reach fixed points. ";
+	cout << "Reported with the statistics, so it does nothing with --concise." << endl << endl;
+
+	cout << "  --stream-output: write each function as soon as it is generated, preceded by the global variables ";
+	cout << "and forward declarations it needs, instead of writing the whole program at the end. ";
+	cout << "The functions and global variables are the same as without the option, but the values picked for array initializers differ. ";
+	cout << "Does not work with --paranoid, --access-once, --max-split-files or the attribute options." << endl << endl;
+
+	cout << "  --profile: output the time and call counts of the generation phases, and counters of the ";
+	cout << "fact analysis, as a JSON object in a comment at the end of the program." << endl << endl;
+
+	cout << "  --direct-sampling: when a random choice is rejected (e.g. a pointer type with --no-pointers), ";
+	cout << "draw the second time from the choices allowed instead of drawing until one is allowed. ";
+	cout << "Faster with restrictive options, but the programs differ from the ones generated without it." << endl << endl;
+
+	cout << "  --callee-summaries: when a call hands a function the same facts, under the same effect context, ";
+	cout << "as an earlier call, reuse the outcome of analyzing the function for that call instead of analyzing its body again. ";
+	cout << "Faster with many calls to the same functions, but the programs may differ from the ones generated without it." << endl << endl;
+
+	cout << "  --rng <lrand48|xoshiro256>: the random number engine (lrand48 by default). ";
+	cout << "xoshiro256 is faster and draws types, function signatures, statements and constants from separate streams, ";
+	cout << "so that a change in one of them does not shift the random choices of the others. ";
+	cout << "The programs differ from the ones lrand48 generates for the same seed." << endl << endl;
+
+	cout << "  --record-trace <file>: write the random decisions made for the program to <file>, a compact binary trace." << endl << endl;
+
+	cout << "  --replay-trace <file>: generate the program recorded in <file> by --record-trace, taking the decisions ";
+	cout << "and the seed from the trace. The other options must be the same as when recording." << endl << endl;
+
 	cout <<	"  --identify-wrappers: assign ids to used safe math wrappers." << endl << endl;
 
 	cout << "  --safe-math-wrappers <id1,id2...>: specifiy ids of wrapper functions that are necessary to avoid undefined behaviors, use 0 to specify none." << endl << endl;
@@ -351,6 +459,150 @@ static void print_advanced_help()
     cout << "  --ptr-size <size>: specify pointer size of target (default taken from platform.info if it exists otherwise from host)"  << endl << endl;
 }
 
+/*
+ * generate the program of <seed> in batch mode, to <dir>/<seed>.c or to <out>
+ */
+static void
+generate_one(int argc, char **argv, unsigned long seed, ostream *out)
+{
+	if (g_BatchDir.empty()) {
+		CGOptions::output_file("");
+		DefaultOutputMgr::set_main_out(out);
+	}
+	else {
+		ostringstream ss;
+		ss << g_BatchDir << "/" << seed << ".c";
+		CGOptions::output_file(ss.str());
+	}
+
+	AbsProgramGenerator *generator = AbsProgramGenerator::CreateInstance(argc, argv, seed);
+	if (!generator) {
+		cout << "error: can't create generator!" << std::endl;
+		exit(-1);
+	}
+	generator->goGenerator();
+	delete generator;
+	DefaultOutputMgr::set_main_out(NULL);
+}
+
+static void
+output_frame(ostream &frames, unsigned long seed, const string &program)
+{
+	frames << "/* csmith seed " << seed << ": " << program.size() << " bytes */" << std::endl;
+	frames << program;
+	frames.flush();
+}
+
+/*
+ * The programs shared by the workers of --jobs. Workers take the seeds in
+ * order, and may run ahead of the frames written so far by at most a few
+ * programs each, so that memory stays bounded.
+ */
+struct BatchQueue {
+	std::mutex mutex;
+	std::condition_variable cond;
+	unsigned long next;				// the next program to generate
+	unsigned long written;			// the programs written so far
+	unsigned long window;
+	map<unsigned long, string> done;	// generated but not written yet
+};
+
+static void
+batch_worker(int argc, char **argv, BatchQueue *q, bool access_once, bool match_exact_qualifiers)
+{
+	// the options changed while generating are per thread, start from the parsed ones
+	CGOptions::access_once(access_once);
+	CGOptions::match_exact_qualifiers(match_exact_qualifiers);
+
+	for (;;) {
+		unsigned long n;
+		{
+			std::unique_lock<std::mutex> lock(q->mutex);
+			q->cond.wait(lock, [q] { return q->next >= g_Count || q->next < q->written + q->window; });
+			if (q->next >= g_Count)
+				return;
+			n = q->next++;
+		}
+		ostringstream program;
+		generate_one(argc, argv, g_Seed + n, &program);
+		{
+			std::lock_guard<std::mutex> lock(q->mutex);
+			q->done[n] = program.str();
+		}
+		q->cond.notify_all();
+	}
+}
+
+/*
+ * generate the programs of batch mode. Options are parsed only once, while
+ * all the generator state is torn down after each program (see
+ * Finalization::doFinalization) so that every program is the same as the one
+ * generated by a separate run with its seed. With --jobs, the state is per
+ * thread and the programs are generated by a pool of threads.
+ */
+static int
+generate_batch(int argc, char **argv)
+{
+	if (CGOptions::dfs_exhaustive() || CGOptions::max_split_files() > 0) {
+		cout << "error: --seeds and --count do not work with --dfs-exhaustive or --max-split-files" << std::endl;
+		return -1;
+	}
+	if (!CGOptions::record_trace().empty() || !CGOptions::replay_trace().empty()) {
+		cout << "error: --seeds and --count do not work with --record-trace or --replay-trace" << std::endl;
+		return -1;
+	}
+	if (!g_BatchDir.empty() && !create_dir(g_BatchDir.c_str())) {
+		cout << "error: can't create directory " << g_BatchDir << std::endl;
+		return -1;
+	}
+
+	// the frames go where the only program would go otherwise
+	string frame_file = CGOptions::output_file();
+	ofstream frame_ofile;
+	if (g_BatchDir.empty() && !frame_file.empty()) {
+		frame_ofile.open(frame_file.c_str(), ios_base::binary);
+	}
+	ostream &frames = frame_ofile.is_open() ? frame_ofile : cout;
+
+	if (g_Jobs <= 1) {
+		for (unsigned long n = 0; n < g_Count; n++) {
+			ostringstream program;
+			generate_one(argc, argv, g_Seed + n, &program);
+			if (g_BatchDir.empty())
+				output_frame(frames, g_Seed + n, program.str());
+		}
+		return 0;
+	}
+
+	BatchQueue q;
+	q.next = 0;
+	q.written = 0;
+	q.window = 4 * g_Jobs;
+	vector<std::thread> workers;
+	for (unsigned long i = 0; i < g_Jobs; i++) {
+		workers.push_back(std::thread(batch_worker, argc, argv, &q,
+			CGOptions::access_once(), CGOptions::match_exact_qualifiers()));
+	}
+	// write the frames in the order of seeds, as they come in
+	for (unsigned long n = 0; n < g_Count; n++) {
+		string program;
+		{
+			std::unique_lock<std::mutex> lock(q.mutex);
+			q.cond.wait(lock, [&q, n] { return q.done.count(n) > 0; });
+			program.swap(q.done[n]);
+			q.done.erase(n);
+			q.written = n + 1;
+		}
+		q.cond.notify_all();
+		if (g_BatchDir.empty())
+			output_frame(frames, g_Seed + n, program);
+	}
+	for (size_t i = 0; i < workers.size(); i++) {
+		workers[i].join();
+	}
+	return 0;
+}
+
 void arg_check(int argc, int i)
 {
 	if (i >= argc) {
@@ -396,6 +648,44 @@ main(int argc, char **argv)
 			continue;
 		}
 
+		if (strcmp (argv[i], "--seeds") == 0) {
+			unsigned long last = 0;
+			i++;
+			arg_check(argc, i);
+			if (!parse_seed_range_arg(argv[i], &g_Seed, &last))
+				exit(-1);
+			g_Count = last - g_Seed + 1;
+			continue;
+		}
+
+		if (strcmp (argv[i], "--count") == 0) {
+			i++;
+			arg_check(argc, i);
+			if (!parse_int_arg(argv[i], &g_Count))
+				exit(-1);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--jobs") == 0 || strcmp (argv[i], "-j") == 0) {
+			i++;
+			arg_check(argc, i);
+			if (!parse_int_arg(argv[i], &g_Jobs) || g_Jobs == 0) {
+				cout << "please specify <num> > 0" << std::endl;
+				exit(-1);
+			}
+			continue;
+		}
+
+		if (strcmp (argv[i], "--batch-dir") == 0) {
+			i++;
+			arg_check(argc, i);
+			if (!parse_string_arg(argv[i], g_BatchDir)) {
+				cout << "please specify <dir>" << std::endl;
+				exit(-1);
+			}
+			continue;
+		}
+
 		if (strcmp (argv[i], "--max-block-size") == 0) {
 			unsigned long size = 0;
 			i++;
@@ -478,6 +768,11 @@ main(int argc, char **argv)
 			continue;
 		}
 
+		if (strcmp (argv[i], "--balance-split-files") == 0) {
+			CGOptions::balance_split_files(true);
+			continue;
+		}
+
 		if (strcmp (argv[i], "--dfs-exhaustive") == 0) {
 			CGOptions::dfs_exhaustive(true);
 			CGOptions::random_based(false);
@@ -489,6 +784,11 @@ main(int argc, char **argv)
 			continue;
 		}
 
+		if (strcmp (argv[i], "--dfs-prune-duplicates") == 0) {
+			CGOptions::dfs_prune_duplicates(true);
+			continue;
+		}
+
 		if (strcmp (argv[i], "--packed-struct") == 0) {
 			CGOptions::packed_struct(true);
 			continue;
@@ -1098,6 +1398,26 @@ main(int argc, char **argv)
 			continue;
 		}
 
+		if (strcmp (argv[i], "--fast-crc") == 0) {
+			CGOptions::fast_crc(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-fast-crc") == 0) {
+			CGOptions::fast_crc(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--block-hash") == 0) {
+			CGOptions::block_hash(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-block-hash") == 0) {
+			CGOptions::block_hash(false);
+			continue;
+		}
+
 		if (strcmp (argv[i], "--builtins") == 0) {
 			CGOptions::builtins(true);
 			continue;
@@ -1133,6 +1453,50 @@ main(int argc, char **argv)
 			continue;
 		}
 
+		if (strcmp (argv[i], "--budget-time") == 0) {
+			unsigned long num;
+			i++;
+			arg_check(argc, i);
+			if (!parse_int_arg(argv[i], &num))
+				exit(-1);
+			CGOptions::budget_time(num);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--budget-stmts") == 0) {
+			unsigned long num;
+			i++;
+			arg_check(argc, i);
+			if (!parse_int_arg(argv[i], &num))
+				exit(-1);
+			CGOptions::budget_stmts(num);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--budget-fact-iterations") == 0) {
+			unsigned long num;
+			i++;
+			arg_check(argc, i);
+			if (!parse_int_arg(argv[i], &num))
+				exit(-1);
+			CGOptions::budget_fact_iterations(num);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--target-size") == 0 ||
+			strcmp (argv[i], "--target-stmts") == 0) {
+			unsigned long min, max;
+			bool stmts = (strcmp (argv[i], "--target-stmts") == 0);
+			i++;
+			arg_check(argc, i);
+			if (!parse_target_range_arg(argv[i], &min, &max))
+				exit(-1);
+			CGOptions::target_min(min);
+			CGOptions::target_max(max);
+			CGOptions::target_stmts(stmts);
+			continue;
+		}
+
 		if (strcmp (argv[i], "--monitor-funcs") == 0) {
 			string vname;
 			i++;
@@ -1220,6 +1584,67 @@ main(int argc, char **argv)
 			continue;
 		}
 
+		if (strcmp (argv[i], "--fixed-point-stats") == 0) {
+			CGOptions::fixed_point_stats(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--stream-output") == 0) {
+			CGOptions::stream_output(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--profile") == 0) {
+			CGOptions::profile(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--direct-sampling") == 0) {
+			CGOptions::direct_sampling(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--callee-summaries") == 0) {
+			CGOptions::callee_summaries(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--rng") == 0) {
+			string engine;
+			i++;
+			arg_check(argc, i);
+			if (!parse_string_arg(argv[i], engine)) {
+				cout << "please specify lrand48 or xoshiro256" << std::endl;
+				exit(-1);
+			}
+			CGOptions::rng_engine(engine);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--record-trace") == 0) {
+			string file;
+			i++;
+			arg_check(argc, i);
+			if (!parse_string_arg(argv[i], file)) {
+				cout << "please specify the trace file" << std::endl;
+				exit(-1);
+			}
+			CGOptions::record_trace(file);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--replay-trace") == 0) {
+			string file;
+			i++;
+			arg_check(argc, i);
+			if (!parse_string_arg(argv[i], file)) {
+				cout << "please specify the trace file" << std::endl;
+				exit(-1);
+			}
+			CGOptions::replay_trace(file);
+			continue;
+		}
+
 		if (strcmp (argv[i], "--identify-wrappers") == 0) {
 			CGOptions::identify_wrappers(true);
 			continue;
@@ -1551,11 +1976,32 @@ main(int argc, char **argv)
 		CGOptions::fix_options_for_cpp();
 	}
 
+	if (CGOptions::dfs_exhaustive()) {
+		CGOptions::dfs_jobs(g_Jobs);
+	}
+
 	if (CGOptions::has_conflict()) {
 		cout << "error: options conflict - " << CGOptions::conflict_msg() << std::endl;
 		exit(-1);
 	}
 
+	if (g_Count > 0) {
+		return generate_batch(argc, argv);
+	}
+
+	if (!CGOptions::replay_trace().empty()) {
+		string err;
+		DecisionTrace *trace = DecisionTrace::OpenReplay(CGOptions::replay_trace(), err);
+		if (!trace) {
+			cout << "error: " << err << std::endl;
+			exit(-1);
+		}
+		g_Seed = trace->seed();
+	}
+	else if (!CGOptions::record_trace().empty()) {
+		DecisionTrace::CreateRecorder(CGOptions::record_trace(), g_Seed);
+	}
+
 	AbsProgramGenerator *generator = AbsProgramGenerator::CreateInstance(argc, argv, g_Seed);
 	if (!generator) {
 		cout << "error: can't create generator!" << std::endl;
@@ -36,18 +36,18 @@
 #include <cassert>
 #include <iostream>
 #include <string>
-#include "LinearSequence.h"
+#include "PackedSequence.h"
 
-std::set<Sequence*> SequenceFactory::seqs_;
+thread_local std::set<Sequence*> SequenceFactory::seqs_;
 
-char SequenceFactory::current_sep_char_ = '_';
+thread_local char SequenceFactory::current_sep_char_ = '_';
 
 Sequence*
 SequenceFactory::make_sequence()
 {
 	Sequence *seq = NULL;
-	seq = new LinearSequence(LinearSequence::default_sep_char);
-	current_sep_char_ = LinearSequence::default_sep_char;
+	seq = new PackedSequence(PackedSequence::default_sep_char);
+	current_sep_char_ = PackedSequence::default_sep_char;
 
 	assert(seq);
 	seqs_.insert(seq);
@@ -85,11 +85,13 @@
 #include "StringUtils.h"
 #include "VariableSelector.h"
 #include "Attribute.h"
+#include "Budget.h"
+#include "TargetSize.h"
 
 using namespace std;
-const Statement* Statement::failed_stm;
+thread_local const Statement* Statement::failed_stm;
 
-AttributeGenerator Statement::label_attr_generator;
+thread_local AttributeGenerator Statement::label_attr_generator;
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -111,7 +113,9 @@ public:
 
 	virtual bool filter(int v) const;
 
-	static bool label_attr_generate;
+	virtual bool admissible(unsigned int n, std::vector<unsigned int> &values) const;
+
+	static thread_local bool label_attr_generate;
 private:
 	const CGContext &cg_context_;
 };
@@ -130,11 +134,11 @@ StatementFilter::~StatementFilter(void)
 
 }
 
-bool StatementFilter::label_attr_generate = false;
+thread_local bool StatementFilter::label_attr_generate = false;
 
 // use a table to define probabilities of different kinds of statements
 // Must initialize it before use
-ProbabilityTable<unsigned int, ProbName> *Statement::stmtTable_ = NULL;
+thread_local ProbabilityTable<unsigned int, ProbName> *Statement::stmtTable_ = NULL;
 
 void
 Statement::InitProbabilityTable()
@@ -146,6 +150,16 @@ Statement::InitProbabilityTable()
 	Statement::stmtTable_->initialize(pStatementProb);
 }
 
+void
+Statement::doFinalization(void)
+{
+	// the table depends on the probabilities of the program (--random-random)
+	delete Statement::stmtTable_;
+	Statement::stmtTable_ = NULL;
+	Statement::sid = 0;
+	Statement::failed_stm = NULL;
+}
+
 eStatementType
 Statement::number_to_type(unsigned int value)
 {
@@ -178,6 +192,9 @@ bool StatementFilter::filter(int value) const
 	if ((type == eReturn) && no_return) {
 		return true;
 	}
+	if ((type == eReturn) && TargetSize::keep_going(cg_context_.get_current_block())) {
+		return true;
+	}
 
 	if ( (type == eBreak || type == eContinue) && !(cg_context_.flags & IN_LOOP) ) {
 		return true;
@@ -200,6 +217,26 @@ bool StatementFilter::filter(int value) const
 	return false;
 }
 
+/*
+ * Many values map to the same statement type, check each type once
+ */
+bool StatementFilter::admissible(unsigned int n, std::vector<unsigned int> &values) const
+{
+	// partial expansion changes its state when checking a statement type
+	if (PartialExpander::direct_expand_check(MAX_STATEMENT_TYPE))
+		return false;
+
+	vector<int> rejected(MAX_STATEMENT_TYPE, -1);
+	for (unsigned int v = 0; v < n; v++) {
+		eStatementType type = Statement::number_to_type(v);
+		if (rejected[type] < 0)
+			rejected[type] = filter(v);
+		if (!rejected[type])
+			values.push_back(v);
+	}
+	return true;
+}
+
 int find_stm_in_set(const vector<const Statement*>& set, const Statement* s)
 {
     size_t i;
@@ -248,7 +285,7 @@ StatementProbability(const StatementFilter *filter)
 	return Statement::number_to_type(value);
 }
 
-int Statement::sid = 0;
+thread_local int Statement::sid = 0;
 /*
  *
  */
@@ -257,10 +294,12 @@ Statement::make_random(CGContext &cg_context,
 					   eStatementType t)
 {
 	DEPTH_GUARD_BY_TYPE_RETURN_WITH_FLAG(dtStatement, t, NULL);
+	RandomStreamScope stream(rsStatements);
 	// Should initialize table first
 	Statement::InitProbabilityTable();
 
-	if ((CGOptions::stop_by_stmt() >= 0) && (sid >= CGOptions::stop_by_stmt())) {
+	if (((CGOptions::stop_by_stmt() >= 0) && (sid >= CGOptions::stop_by_stmt())) || Budget::check() ||
+		TargetSize::large_enough()) {
 		t = eReturn;
 	}
 
@@ -391,6 +430,7 @@ Statement::Statement(eStatementType st, Block* b)
 {
 	stm_id = Statement::sid;
 	Statement::sid++;
+	stm_index = (b && b->func) ? b->func->stm_cnt++ : 0;
 }
 
 /*
@@ -553,8 +593,8 @@ void
 Statement::set_accumulated_effect_after_block(Effect& eff, const Block* b, CGContext& cg_context) const
 {
 	FactMgr* fm = get_fact_mgr(&cg_context);
-	eff.add_effect(fm->map_stm_effect[b]);
-	fm->map_stm_effect[this] = eff;
+	eff.add_effect(fm->map_stm_effect.get(b));
+	fm->map_stm_effect.set(this, eff);
 }
 
 /*
@@ -564,7 +604,7 @@ void
 Statement::add_back_return_facts(FactMgr* fm, std::vector<const Fact*>& facts) const
 {
 	if (eType == eReturn) {
-		merge_facts(facts, fm->map_facts_out[this]);
+		merge_facts(facts, fm->map_facts_out.get(this));
 	} else {
 		vector<const Block*> blks;
 		get_blocks(blks);
@@ -588,17 +628,18 @@ Statement::shortcut_analysis(vector<const Fact*>& inputs, CGContext& cg_context)
 	// the output facts of control statement (break/continue/goto) has removed local facts
 	// thus can not take this shortcut. (The facts we get should represent all variables
 	// visible in subsequent statement)
-	if (same_facts(inputs, fm->map_facts_in[this]) && !is_ctrl_stmt() && !contains_unfixed_goto())
+	if (same_facts(inputs, fm->map_facts_in.get(this)) && !is_ctrl_stmt() && !contains_unfixed_goto())
 	{
 		//cg_context.get_effect_context().Output(cout);
 		//print_facts(inputs);
 		//fm->map_stm_effect[this].Output(cout);
-		if (cg_context.in_conflict(fm->map_stm_effect[this])) {
+		if (cg_context.in_conflict(fm->map_stm_effect.get(this))) {
 			return 1;
 		}
-		inputs = fm->map_facts_out[this];
-		cg_context.add_effect(fm->map_stm_effect[this]);
-		fm->map_accum_effect[this] = *(cg_context.get_effect_accum());
+		inputs = fm->map_facts_out.get(this);
+		cg_context.add_effect(fm->map_stm_effect.get(this));
+		fm->map_accum_effect.set(this, *(cg_context.get_effect_accum()));
+		fm->stm_shortcut_cnt++;
 		return 0;
 	}
 	return 2;
@@ -651,6 +692,7 @@ Statement::stm_visit_facts(vector<const Fact*>& inputs, CGContext& cg_context) c
 	cg_context.get_effect_stm().clear();
 	cg_context.curr_blk = parent;
 	FactMgr* fm = get_fact_mgr(&cg_context);
+	fm->stm_analysis_cnt++;
 	bool ok = visit_facts(inputs, cg_context);
 
 
@@ -660,7 +702,7 @@ Statement::stm_visit_facts(vector<const Fact*>& inputs, CGContext& cg_context) c
 	//if (!FactPointTo::is_valid_ptr("g_75", inputs))
 	//	Output(cout, fm);
 	fm->remove_rv_facts(inputs);
-	fm->map_accum_effect[this] = *(cg_context.get_effect_accum());
+	fm->map_accum_effect.set(this, *(cg_context.get_effect_accum()));
 	fm->map_visited[this] = true;
 	return ok;
 }
@@ -712,7 +754,7 @@ Statement::read_union_field(void) const
 {
 	FactMgr* fm = get_fact_mgr_for_func(func);
 	assert(fm);
-	if (fm->map_stm_effect[this].union_field_is_read()) {
+	if (fm->map_stm_effect.get(this).union_field_is_read()) {
 		return true;
 	}
 	vector<const FunctionInvocationUser*> calls;
@@ -843,14 +885,14 @@ Statement::contains_unfixed_goto(void) const
 		}
 		if (edge->src->eType == eGoto && fm->map_visited[edge->src] && contains_stmt(edge->dest)) {
 			// take care the special case caused by StatementGoto::visit_facts
-			if (!fm->map_facts_out[edge->src].empty() && fm->map_facts_in[edge->dest].empty()) {
+			if (!fm->map_facts_out.get(edge->src).empty() && fm->map_facts_in.get(edge->dest).empty()) {
 				return true;
 			}
-			for (j=0; j<fm->map_facts_in[edge->dest].size(); j++) {
-				const Fact* f = fm->map_facts_in[edge->dest][j];
+			for (j=0; j<fm->map_facts_in.get(edge->dest).size(); j++) {
+				const Fact* f = fm->map_facts_in.get(edge->dest)[j];
 				// ignore return variable facts
 				if (!f->get_var()->is_rv()) {
-					const Fact* jump_src_f = find_related_fact(fm->map_facts_out[edge->src], f);
+					const Fact* jump_src_f = find_related_fact(fm->map_facts_out.get(edge->src), f);
 					if (jump_src_f && !f->imply(*jump_src_f)) {
 						return true;
 					}
@@ -875,8 +917,8 @@ Statement::analyze_with_edges_in(vector<const Fact*>& inputs, CGContext& cg_cont
 		for (i=0; i<edges.size(); i++) {
 			const Statement* src = edges[i]->src;
 			if (fm->map_visited[src]) {
-				FactMgr::merge_jump_facts(inputs, fm->map_facts_out[src]);
-				cg_context.add_effect(fm->map_accum_effect[src]);
+				FactMgr::merge_jump_facts(inputs, fm->map_facts_out.get(src));
+				cg_context.add_effect(fm->map_accum_effect.get(src));
 			}
 		}
 	}
@@ -886,8 +928,8 @@ Statement::analyze_with_edges_in(vector<const Fact*>& inputs, CGContext& cg_cont
 		for (i=0; i<edges.size(); i++) {
 			const Statement* src = edges[i]->src;
 			if (fm->map_visited[src]) {
-				FactMgr::merge_jump_facts(inputs, fm->map_facts_out[src]);
-				cg_context.add_effect(fm->map_accum_effect[src]);
+				FactMgr::merge_jump_facts(inputs, fm->map_facts_out.get(src));
+				cg_context.add_effect(fm->map_accum_effect.get(src));
 			}
 		}
 	}
@@ -913,7 +955,7 @@ Statement::post_creation_analysis(vector<const Fact*>& pre_facts, const Effect&
 	// save the effect for this statement if this is a simple statement
 	// for compound statements, it's effect is saved in make_random
 	if (!is_compound(eType)) {
-		fm->map_stm_effect[this] = cg_context.get_effect_stm();
+		fm->map_stm_effect.set(this, cg_context.get_effect_stm());
 	}
 
 	bool special_handled = false;
@@ -948,7 +990,7 @@ Statement::post_creation_analysis(vector<const Fact*>& pre_facts, const Effect&
 	fm->remove_rv_facts(fm->global_facts);
 	fm->set_fact_in(this, pre_facts);
 	fm->set_fact_out(this, fm->global_facts);
-	fm->map_accum_effect[this] = *(cg_context.get_effect_accum());
+	fm->map_accum_effect.set(this, *(cg_context.get_effect_accum()));
 	fm->map_visited[this] = true;
 }
 
@@ -964,7 +1006,7 @@ Statement::pre_output(std::ostream &out, FactMgr* /* fm */, int indent) const
 		assert(gotos.size() > 0);
 		out << gotos[0]->label << ":";
 		label_attr_generator.Output(out);
-		out << endl;
+		out << '\n';
 		return 1;
 		//for (j=0; j<gotos.size(); j++) {
 		//	gotos[j]->output_skipped_var_inits(out, indent);
@@ -97,6 +97,8 @@ public:
 								  eStatementType t = MAX_STATEMENT_TYPE);
 	static eStatementType number_to_type(unsigned int value);
 
+	static void doFinalization(void);
+
 	virtual ~Statement(void);
 
 	eStatementType get_type(void) const { return eType; }
@@ -187,20 +189,22 @@ public:
 
 	int get_blk_depth(void) const;
 
-	static AttributeGenerator label_attr_generator;
+	static thread_local AttributeGenerator label_attr_generator;
 
 	// unique id for each statement
 	int stm_id;
+	// dense id of the statement within its function, the body has 0
+	int stm_index;
 	Function* func;
 	Block* parent;
-	static const Statement* failed_stm;
+	static thread_local const Statement* failed_stm;
 
-	static ProbabilityTable<unsigned int, ProbName> *stmtTable_;
+	static thread_local ProbabilityTable<unsigned int, ProbName> *stmtTable_;
 protected:
 	Statement(eStatementType st, Block* parent);
 
 private:
-	static int sid;
+	static thread_local int sid;
 
 	Statement &operator=(const Statement &s); // unimplementable
 
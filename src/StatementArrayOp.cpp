@@ -151,7 +151,7 @@ StatementArrayOp::make_random_array_init(CGContext &cg_context)
 	if (FactMgr::update_fact_for_assign(&lhs, init, fm->global_facts)) {
 		cg_context.get_current_func()->fact_changed = true;
 	}
-	fm->map_stm_effect[sa] = cg_context.get_effect_stm();
+	fm->map_stm_effect.set(sa, cg_context.get_effect_stm());
 
 	// clear IV list from cg_context
 	for (i=0; i<cvs.size(); i++) {
@@ -312,7 +312,7 @@ StatementArrayOp::visit_facts(vector<const Fact*>& inputs, CGContext& cg_context
 		if (body->must_return()) {
 			inputs = facts_copy;
 		} else {
-			inputs = fm->map_facts_in[body];
+			inputs = fm->map_facts_in.get(body);
 		}
 		// include the facts from "break" statements
 		// find edges leading to the end of this statement, and merge
@@ -320,7 +320,7 @@ StatementArrayOp::visit_facts(vector<const Fact*>& inputs, CGContext& cg_context
 		find_edges_in(edges, true, false);
 		for (i=0; i<edges.size(); i++) {
 			const Statement* src = edges[i]->src;
-			FactMgr::merge_jump_facts(inputs, fm->map_facts_out[src]);
+			FactMgr::merge_jump_facts(inputs, fm->map_facts_out.get(src));
 		}
 		// compute accumulated effect
 		set_accumulated_effect_after_block(eff, body, cg_context);
@@ -335,7 +335,7 @@ StatementArrayOp::visit_facts(vector<const Fact*>& inputs, CGContext& cg_context
 			return log_analysis_fail("StatementArrayOp lhs");
 		}
 		FactMgr::update_fact_for_assign(&lhs, init_value, inputs);
-		fm->map_stm_effect[this] = cg_context.get_effect_stm();
+		fm->map_stm_effect.set(this, cg_context.get_effect_stm());
 	}
 	return true;
 }
@@ -65,11 +65,12 @@ using namespace std;
 //
 // use a table to define probabilities of different kinds of statements
 // Must initialize it before use
-DistributionTable StatementAssign::assignOpsTable_;
+thread_local DistributionTable StatementAssign::assignOpsTable_;
 
 void
 StatementAssign::InitProbabilityTable()
 {
+	assignOpsTable_.clear();
 	assignOpsTable_.add_entry((int)eSimpleAssign, 70);
 	assignOpsTable_.add_entry((int)eBitAndAssign, 10);
 	assignOpsTable_.add_entry((int)eBitXorAssign, 10);
@@ -105,6 +106,7 @@ StatementAssign::AssignOpsProbability(const Type* type)
 	}
 
 	int value = rnd_upto(filter.get_max_prob(), &filter);
+	ERROR_GUARD(MAX_ASSIGN_OP);
 	return (eAssignOps)(filter.lookup(value));
 }
 
@@ -116,12 +118,14 @@ StatementAssign::make_random(CGContext &cg_context, const Type* type, const CVQu
 {
 	// decide assignment operator
 	eAssignOps op = AssignOpsProbability(type);
+	ERROR_GUARD(NULL);
 	// bool stand_alone_assign = false;
 
 	// decide type
 	if (type == NULL) {
 		// stand_alone_assign = true;
 		type = Type::SelectLType(!cg_context.get_effect_context().is_side_effect_free(), op);
+		ERROR_GUARD(NULL);
 	}
 	assert(!type->is_const_struct_union());
 
@@ -359,7 +363,7 @@ StatementAssign::visit_facts(vector<const Fact*>& inputs, CGContext& cg_context)
 	FactMgr::update_fact_for_assign(this, inputs);
 	// save effect
 	FactMgr* fm = get_fact_mgr(&cg_context);
-	fm->map_stm_effect[this] = cg_context.get_effect_stm();
+	fm->map_stm_effect.set(this, cg_context.get_effect_stm());
 	return true;
 }
 
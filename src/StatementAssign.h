@@ -141,7 +141,7 @@ private:
 	std::string tmp_var1;
 	std::string tmp_var2;
 
-	static DistributionTable assignOpsTable_;
+	static thread_local DistributionTable assignOpsTable_;
 
 	StatementAssign(const StatementAssign &sa);  // unimplemented
 
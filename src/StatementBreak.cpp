@@ -144,7 +144,7 @@ StatementBreak::visit_facts(vector<const Fact*>& inputs, CGContext& cg_context)
 		return log_analysis_fail("StatementBreak");
 	}
 	FactMgr* fm = get_fact_mgr(&cg_context);
-	fm->map_stm_effect[this] = cg_context.get_effect_stm();
+	fm->map_stm_effect.set(this, cg_context.get_effect_stm());
 	return true;
 }
 
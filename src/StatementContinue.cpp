@@ -144,7 +144,7 @@ StatementContinue::visit_facts(vector<const Fact*>& inputs, CGContext& cg_contex
 		return log_analysis_fail("StatementContinue");
 	}
 	FactMgr* fm = get_fact_mgr(&cg_context);
-	fm->map_stm_effect[this] = cg_context.get_effect_stm();
+	fm->map_stm_effect.set(this, cg_context.get_effect_stm());
 	return true;
 }
 
@@ -299,12 +299,15 @@ StatementFor::make_random_array_loop(const CGContext &cg_context)
 {
 	// select the number of arrays to manipulate, default maximum = 4;
 	unsigned int aryno = rnd_upto(CGOptions::max_array_num_in_loop());
+	ERROR_GUARD(NULL);
 	// choose arrays to manipulate, create new ones if necessary
 	VariableSet must_reads, must_writes;
 	for (size_t i=0; i<aryno; i++) {
 		const ArrayVariable* av = VariableSelector::select_array(cg_context);
+		ERROR_GUARD(NULL);
 		// random access choice: 0 = must read, 1 = must write, 2 = both
 		int access = rnd_upto(3);
+		ERROR_GUARD(NULL);
 		if (access == 0 || access == 2) {
 			add_variable_to_set(must_reads, (const Variable*)av);
 		}
@@ -337,7 +340,7 @@ StatementFor::post_loop_analysis(CGContext& cg_context, vector<const Fact*>& pre
 	assert(fm);
 	// if the control reached the end of this for-loop with must-return body, it means
 	// the loop is never entered. restore facts to pre-loop env
-	fm->global_facts = fm->map_facts_in[&body];
+	fm->global_facts = fm->map_facts_in.get(&body);
 	if (body.must_return()) {
 		fm->restore_facts(pre_facts);
 	}
@@ -345,7 +348,7 @@ StatementFor::post_loop_analysis(CGContext& cg_context, vector<const Fact*>& pre
 	for (size_t i=0; i<body.break_stms.size(); i++) {
 		const StatementBreak* stm = dynamic_cast<const StatementBreak*>(body.break_stms[i]);
 		fm->create_cfg_edge(stm, this, true, false);
-		FactMgr::merge_jump_facts(fm->global_facts, fm->map_facts_out[stm]);
+		FactMgr::merge_jump_facts(fm->global_facts, fm->map_facts_out.get(stm));
 	}
 	// compute accumulated effect
 	set_accumulated_effect_after_block(pre_effect, &body, cg_context);
@@ -445,7 +448,7 @@ StatementFor::visit_facts(vector<const Fact*>& inputs, CGContext& cg_context) co
 	if (body.must_return()) {
 		inputs = facts_copy;
 	} else {
-		inputs = fm->map_facts_in[&body];
+		inputs = fm->map_facts_in.get(&body);
 	}
 
 	// include the facts from "break" statements
@@ -455,7 +458,7 @@ StatementFor::visit_facts(vector<const Fact*>& inputs, CGContext& cg_context) co
 	find_edges_in(edges, true, false);
 	for (i=0; i<edges.size(); i++) {
 		const Statement* src = edges[i]->src;
-		FactMgr::merge_jump_facts(inputs, fm->map_facts_out[src]);
+		FactMgr::merge_jump_facts(inputs, fm->map_facts_out.get(src));
 	}
 	// compute accumulated effect
 	set_accumulated_effect_after_block(eff, &body, cg_context);
@@ -54,7 +54,7 @@
 
 using namespace std;
 
-std::map<const Statement*, string> StatementGoto::stm_labels;
+thread_local std::map<const Statement*, string> StatementGoto::stm_labels;
 
 ///////////////////////////////////////////////////////////////////////////////
 /*
@@ -122,7 +122,7 @@ StatementGoto::make_random(CGContext &cg_context)
 		} else {
 			// travel in time, find a suitable variable read at generation time of the other statement
 			cond_var = VariableSelector::choose_visible_read_var(ok_blk,
-				fm->map_accum_effect[other_stm].get_read_vars(), get_int_type(), fm->map_facts_out[other_stm]);
+				fm->map_accum_effect.get(other_stm).get_read_vars(), get_int_type(), fm->map_facts_out.get(other_stm));
 		}
 		if (cond_var == 0) {
 			return NULL;
@@ -154,16 +154,16 @@ StatementGoto::make_random(CGContext &cg_context)
 			bool ok = true;
 			bool found_new_facts = false;
 			// JYTODO: don't assume facts_in == facts_out for control statements
-			FactVec& goto_in = other_stm->is_ctrl_stmt() ? fm->map_facts_in[other_stm] : fm->map_facts_out[other_stm];
+			const FactSet& goto_in = other_stm->is_ctrl_stmt() ? fm->map_facts_in.get(other_stm) : fm->map_facts_out.get(other_stm);
 			FactMgr::update_facts_for_dest(goto_in, goto_out, stm);
-			stm_in = fm->map_facts_in[stm];
+			stm_in = fm->map_facts_in.get(stm);
 			Effect pre_effect = cg_context.get_accum_effect();
 			// merge the effect from goto src
-			cg_context.add_effect(fm->map_accum_effect[other_stm]);
+			cg_context.add_effect(fm->map_accum_effect.get(other_stm));
 			if (FactMgr::merge_jump_facts(stm_in, goto_out)) {
 				stm_out = stm_in;
 				found_new_facts = true;
-				map<const Statement*, FactVec> facts_in_copy, facts_out_copy;
+				map<const Statement*, FactSet> facts_in_copy, facts_out_copy;
 				fm->backup_stm_fact_maps(stm, facts_in_copy, facts_out_copy);
 				ok = stm->stm_visit_facts(stm_out, cg_context);
 				if (!ok) {
@@ -196,12 +196,12 @@ StatementGoto::make_random(CGContext &cg_context)
 				fm->set_fact_out(stm, stm_out);
 			}
 			fm->create_cfg_edge(sg, stm, false, false);
-			fm->global_facts = fm->map_facts_out[stm];
+			fm->global_facts = fm->map_facts_out.get(stm);
 			// special handling for control statements: their output facts has been altered for oos variables
 			// use the input facts intead (warning: this rely on the assumption that these statements doesn't
 			// change fact env.
 			if (stm->is_ctrl_stmt() || stm->eType == eReturn) {
-				fm->global_facts = fm->map_facts_in[stm];
+				fm->global_facts = fm->map_facts_in.get(stm);
 			}
 			Bookkeeper::forward_jump_cnt++;
 		}
@@ -398,15 +398,15 @@ StatementGoto::visit_facts(vector<const Fact*>& inputs, CGContext& cg_context) c
 	 */
 	if (!fm->map_visited[this] &&
 		!fm->map_visited[dest] &&
-		!same_facts(inputs, fm->map_facts_out[this]) &&
-		subset_facts(inputs, fm->map_facts_out[this])) {
+		!same_facts(inputs, fm->map_facts_out.get(this)) &&
+		subset_facts(inputs, fm->map_facts_out.get(this))) {
 			//print_facts(inputs);
 			//cout << endl;
 			//print_facts(fm->map_facts_out[this]);
 			fm->map_facts_in[dest].clear();
 			fm->map_facts_out[dest].clear();
 	}
-	fm->map_stm_effect[this] = cg_context.get_effect_stm();
+	fm->map_stm_effect.set(this, cg_context.get_effect_stm());
 	return true;
 }
 
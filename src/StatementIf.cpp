@@ -94,7 +94,7 @@ StatementIf::make_random(CGContext &cg_context)
 	ERROR_GUARD_AND_DEL1(NULL, expr);
 
 	// generate false branch with the same env as true branch
-	fm->global_facts = fm->map_facts_in[if_true];
+	fm->global_facts = fm->map_facts_in.get(if_true);
 	Block *if_false = Block::make_random(cg_context);
 	ERROR_GUARD_AND_DEL2(NULL, expr, if_true);
 
@@ -229,8 +229,8 @@ StatementIf::combine_branch_facts(vector<const Fact*>& pre_facts) const
 {
 	FactMgr* fm = get_fact_mgr_for_func(func);
 	FactVec& outputs = fm->global_facts;
-	fm->makeup_new_var_facts(pre_facts, fm->map_facts_out[&if_true]);
-	fm->makeup_new_var_facts(pre_facts, fm->map_facts_out[&if_false]);
+	fm->makeup_new_var_facts(pre_facts, fm->map_facts_out.get(&if_true));
+	fm->makeup_new_var_facts(pre_facts, fm->map_facts_out.get(&if_false));
 
 	bool true_must_return = if_true.must_return();
 	bool false_must_return = if_false.must_return();
@@ -241,17 +241,17 @@ StatementIf::combine_branch_facts(vector<const Fact*>& pre_facts) const
 	else if (true_must_return) {
 		// since false branch is created after true branch, it's output should
 		// have all the variables created in true branch already
-		outputs = fm->map_facts_out[&if_false];
+		outputs = fm->map_facts_out.get(&if_false);
 	}
 	else if (false_must_return) {
-		outputs = fm->map_facts_out[&if_true];
+		outputs = fm->map_facts_out.get(&if_true);
 		// if skip the outcome from false branch, don't forget facts of those variables
 		// created in false branch
-		fm->makeup_new_var_facts(outputs, fm->map_facts_in[&if_false]);
+		fm->makeup_new_var_facts(outputs, fm->map_facts_in.get(&if_false));
 	}
 	else {
-		outputs = fm->map_facts_out[&if_true];
-		merge_facts(outputs, fm->map_facts_out[&if_false]);
+		outputs = fm->map_facts_out.get(&if_true);
+		merge_facts(outputs, fm->map_facts_out.get(&if_false));
 	}
 }
 
@@ -0,0 +1,246 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef STATEMENT_MAP_H
+#define STATEMENT_MAP_H
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cassert>
+#include <deque>
+#include <utility>
+#include <vector>
+#include "Statement.h"
+
+/*
+ * A table from statements of one function to per-statement analysis state.
+ *
+ * Every statement carries a dense index within its function (see
+ * Statement::stm_index), so the table is an array lookup instead of a tree
+ * search keyed by pointer. Values live in a deque so that references into the
+ * table stay valid when it grows. Slot 0 holds the value for the NULL
+ * statement.
+ *
+ * Between checkpoint() and commit()/rollback() the table keeps an undo log:
+ * the first time a slot is looked up for writing, its old value is saved, so
+ * a rollback restores only the slots changed since the checkpoint instead of
+ * a copy of the whole table. Reads go through get(), which saves nothing for
+ * a slot already in use. Checkpoints nest.
+ */
+template <class T>
+class StatementMap
+{
+public:
+	StatementMap(void) : epoch_(0), next_epoch_(0) {}
+
+	T& operator[](const Statement* stm);
+
+	/* read-only lookup, adds the key like operator[] if missing */
+	const T& get(const Statement* stm);
+
+	/* operator[] assignment that leaves an equal value alone */
+	void set(const Statement* stm, const T& value);
+
+	/* number of slots, some of which may be unused */
+	size_t slots(void) const { return keys_.size(); }
+
+	/* whether a slot has been looked up, the same as having a key in a std::map */
+	bool has(size_t slot) const { return present_[slot] != 0; }
+
+	const Statement* key(size_t slot) const { return keys_[slot]; }
+
+	T& value(size_t slot);
+	const T& get_value(size_t slot) const { return values_[slot]; }
+
+	void clear(void);
+
+	void checkpoint(void);
+
+	void commit(void);
+
+	void rollback(void);
+
+private:
+	void log(size_t slot);
+
+	struct Undo {
+		size_t slot;
+		char present;
+		T value;
+	};
+
+	std::deque<T> values_;
+	std::vector<const Statement*> keys_;
+	std::vector<char> present_;
+
+	// the old values, and where each open checkpoint starts in them
+	std::vector<Undo> undo_;
+	std::vector<size_t> marks_;
+
+	// the checkpoint a slot was last saved for, 0 for none
+	std::vector<unsigned> logged_;
+	std::vector<unsigned> epochs_;
+	unsigned epoch_;
+	unsigned next_epoch_;
+};
+
+template <class T>
+T&
+StatementMap<T>::operator[](const Statement* stm)
+{
+	size_t slot = stm ? stm->stm_index + 1 : 0;
+	if (slot >= keys_.size()) {
+		values_.resize(slot + 1);
+		keys_.resize(slot + 1, 0);
+		present_.resize(slot + 1, 0);
+		logged_.resize(slot + 1, 0);
+	}
+	if (epoch_ && logged_[slot] != epoch_)
+		log(slot);
+	if (!present_[slot]) {
+		keys_[slot] = stm;
+		present_[slot] = 1;
+	}
+	// statements of different functions never share a table
+	assert(keys_[slot] == stm);
+	return values_[slot];
+}
+
+/*
+ * A missing slot holds a default value, so adding its key is the only change
+ * to log, and that is cheap.
+ */
+template <class T>
+const T&
+StatementMap<T>::get(const Statement* stm)
+{
+	size_t slot = stm ? stm->stm_index + 1 : 0;
+	if (slot < keys_.size() && present_[slot]) {
+		assert(keys_[slot] == stm);
+		return values_[slot];
+	}
+	return (*this)[stm];
+}
+
+template <class T>
+void
+StatementMap<T>::set(const Statement* stm, const T& value)
+{
+	if (!(get(stm) == value))
+		(*this)[stm] = value;
+}
+
+template <class T>
+T&
+StatementMap<T>::value(size_t slot)
+{
+	if (epoch_ && logged_[slot] != epoch_)
+		log(slot);
+	return values_[slot];
+}
+
+template <class T>
+void
+StatementMap<T>::clear(void)
+{
+	assert(marks_.empty());
+	values_.clear();
+	keys_.clear();
+	present_.clear();
+	logged_.clear();
+}
+
+template <class T>
+void
+StatementMap<T>::log(size_t slot)
+{
+	Undo u = { slot, present_[slot], values_[slot] };
+	undo_.push_back(u);
+	logged_[slot] = epoch_;
+}
+
+template <class T>
+void
+StatementMap<T>::checkpoint(void)
+{
+	marks_.push_back(undo_.size());
+	epochs_.push_back(epoch_);
+	epoch_ = ++next_epoch_;
+}
+
+/*
+ * Keep the changes since the last checkpoint. They stay in the log of an
+ * enclosing checkpoint, if any.
+ */
+template <class T>
+void
+StatementMap<T>::commit(void)
+{
+	assert(!marks_.empty());
+	marks_.pop_back();
+	epoch_ = epochs_.back();
+	epochs_.pop_back();
+	if (marks_.empty())
+		undo_.clear();
+}
+
+/*
+ * Put back every slot changed since the last checkpoint, newest first, so a
+ * slot saved twice ends up with its oldest value.
+ */
+template <class T>
+void
+StatementMap<T>::rollback(void)
+{
+	assert(!marks_.empty());
+	size_t mark = marks_.back();
+	while (undo_.size() > mark) {
+		Undo &u = undo_.back();
+		present_[u.slot] = u.present;
+		if (u.present)
+			std::swap(values_[u.slot], u.value);
+		else
+			values_[u.slot] = T();
+		undo_.pop_back();
+	}
+	marks_.pop_back();
+	epoch_ = epochs_.back();
+	epochs_.pop_back();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // STATEMENT_MAP_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -96,7 +96,7 @@ StatementReturn::visit_facts(vector<const Fact*>& inputs, CGContext& cg_context)
 	}
 	FactMgr::update_fact_for_return(this, inputs);
 	FactMgr* fm = get_fact_mgr(&cg_context);
-	fm->map_stm_effect[this] = cg_context.get_effect_stm();
+	fm->map_stm_effect.set(this, cg_context.get_effect_stm());
 	return true;
 }
 
@@ -137,7 +137,7 @@ StatementReturn::Output(std::ostream &out, FactMgr* /*fm*/, int indent) const
 	output_tab(out, indent);
 	// XXX --- Fix this.  Outputting two stmts instead of one is bad mojo.
 	if (CGOptions::depth_protect()) {
-		out << "DEPTH--;" << endl;
+		out << "DEPTH--;" << '\n';
 	}
 	out << "return ";
 	var.Output(out);
@@ -0,0 +1,224 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#if HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "TargetSize.h"
+#include <ostream>
+#include <string>
+#include <streambuf>
+#include <vector>
+
+#include "ArrayVariable.h"
+#include "Block.h"
+#include "CGOptions.h"
+#include "Function.h"
+#include "Statement.h"
+#include "Type.h"
+#include "Variable.h"
+#include "VariableSelector.h"
+
+using namespace std;
+
+// the size of the program without functions and globals: the headers,
+// main, and the checksum code
+static const unsigned long base_bytes = 2000;
+
+// for unfinished statements before any function is finished
+static const unsigned long default_bytes_per_stmt = 60;
+
+thread_local bool TargetSize::active = false;
+thread_local unsigned long TargetSize::finished_bytes = 0;
+thread_local unsigned long TargetSize::finished_stmts = 0;
+thread_local unsigned long TargetSize::globals_done = 0;
+
+/*
+ * Counts what is written to it and throws it away
+ */
+class SizeCounter : public std::streambuf
+{
+public:
+	SizeCounter() : count(0) {}
+
+	unsigned long count;
+
+protected:
+	virtual int_type overflow(int_type c) {
+		if (c != traits_type::eof())
+			count++;
+		return traits_type::not_eof(c);
+	}
+
+	virtual std::streamsize xsputn(const char *, std::streamsize n) {
+		count += n;
+		return n;
+	}
+};
+
+/*
+ * What main prints to hash a global: a line for each integer in it, inside
+ * a loop for each dimension of an array. It cannot be printed before the
+ * end, the names of the loop variables and the facts of func_1 are not
+ * known yet.
+ */
+static unsigned long
+hash_bytes(const Variable *var)
+{
+	vector<string> names;
+	vector<const Type *> types;
+	vector<int> excluded;
+	var->type->get_int_subfield_names("", names, types, excluded);
+
+	unsigned long dims = var->get_dimension();
+	unsigned long indent = 4 * (1 + dims);
+	unsigned long name = var->get_actual_name().size() + 3 * dims;
+	unsigned long bytes = 0;
+	for (size_t i = 0; i < names.size(); i++) {
+		// transparent_crc(g_1[i].f0, "g_1[i].f0", print_hash_value);
+		bytes += indent + 2 * (name + names[i].size()) + 41;
+	}
+	if (dims > 0 && !names.empty()) {
+		// the loops, and printing the index
+		bytes += dims * 40 + 6 * dims * (dims - 1) + indent + 44 + 7 * dims;
+	}
+	return bytes;
+}
+
+void
+TargetSize::start(void)
+{
+	active = CGOptions::target_min() > 0 || CGOptions::target_max() > 0;
+	finished_bytes = 0;
+	finished_stmts = 0;
+	globals_done = 0;
+}
+
+/*
+ * Measure a function once it is complete. Printing must not change the
+ * program: the non-uniform array initializers depend on what was printed
+ * before, and with the attribute options printing would draw random
+ * numbers, they conflict with --target-size.
+ */
+void
+TargetSize::add_function(Function *f)
+{
+	if (!active) {
+		return;
+	}
+	// stm_cnt starts at 1, for the body that is not counted
+	finished_stmts += f->stm_cnt;
+	if (CGOptions::target_stmts()) {
+		return;
+	}
+	SizeCounter counter;
+	ostream out(&counter);
+	unsigned init_seed = ArrayVariable::get_init_seed();
+	f->OutputForwardDecl(out);
+	f->Output(out);
+	ArrayVariable::set_init_seed(init_seed);
+	finished_bytes += counter.count;
+}
+
+unsigned long
+TargetSize::estimate(void)
+{
+	unsigned long stmts = Statement::get_current_sid();
+	if (CGOptions::target_stmts()) {
+		return stmts;
+	}
+
+	const vector<Variable*> &globals = *VariableSelector::GetGlobalVariables();
+	if (globals_done < globals.size()) {
+		SizeCounter counter;
+		ostream out(&counter);
+		vector<Variable*> vars(globals.begin() + globals_done, globals.end());
+		unsigned init_seed = ArrayVariable::get_init_seed();
+		OutputVariableList(vars, out);
+		ArrayVariable::set_init_seed(init_seed);
+		finished_bytes += counter.count;
+		for (size_t i = 0; i < vars.size(); i++) {
+			finished_bytes += hash_bytes(vars[i]);
+		}
+		globals_done = globals.size();
+	}
+
+	unsigned long unfinished = stmts > finished_stmts ? stmts - finished_stmts : 0;
+	unsigned long per_stmt = finished_stmts ? finished_bytes / finished_stmts : default_bytes_per_stmt;
+	return base_bytes + finished_bytes + unfinished * per_stmt;
+}
+
+bool
+TargetSize::too_small(void)
+{
+	return active && estimate() < static_cast<unsigned long>(CGOptions::target_min());
+}
+
+/*
+ * Only the top level of the body of the first function: the program is
+ * small because func_1 returns early. Growing the other functions as well
+ * would also change the programs that are big enough anyway.
+ */
+bool
+TargetSize::keep_going(const Block *b)
+{
+	return active && b && !b->parent && b->func == GetFirstFunction() && too_small();
+}
+
+/*
+ * Halfway into the range, so that the statements still needed to finish
+ * the program do not push it past the maximum
+ */
+bool
+TargetSize::large_enough(void)
+{
+	if (!active || CGOptions::target_max() <= 0) {
+		return false;
+	}
+	unsigned long min = CGOptions::target_min();
+	unsigned long max = CGOptions::target_max();
+	return estimate() >= min + (max - min) / 2;
+}
+
+void
+TargetSize::doFinalization(void)
+{
+	active = false;
+	finished_bytes = 0;
+	finished_stmts = 0;
+	globals_done = 0;
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,84 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2026 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef TARGET_SIZE_H
+#define TARGET_SIZE_H
+
+class Block;
+class Function;
+
+/*
+ * Steer the generation toward a program size given with --target-size
+ * (bytes) or --target-stmts (statements), so that the caller does not have
+ * to throw away programs and try another seed. The size is estimated while
+ * the program grows: functions are measured by rendering them as they are
+ * finished, statements of unfinished functions count for the average size
+ * of a finished statement. While the estimate is below the minimum, the
+ * body of the first function keeps growing, as the program is small when
+ * it returns early; once the estimate is halfway into the range, the
+ * program is finished the way --stop-by-stmt finishes it.
+ */
+class TargetSize
+{
+public:
+	static void start(void);
+
+	// a function is complete, see Function::stream_output
+	static void add_function(Function *f);
+
+	// true if the block should get more statements and no return
+	static bool keep_going(const Block *b);
+
+	static bool large_enough(void);
+
+	static void doFinalization(void);
+
+private:
+	static unsigned long estimate(void);
+
+	static bool too_small(void);
+
+	static thread_local bool active;
+
+	static thread_local unsigned long finished_bytes;
+
+	static thread_local unsigned long finished_stmts;
+
+	// the globals rendered into finished_bytes so far
+	static thread_local unsigned long globals_done;
+};
+
+#endif // TARGET_SIZE_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
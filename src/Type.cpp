@@ -63,17 +63,18 @@ using namespace std;
 /*
  *
  */
-const Type *Type::simple_types[MAX_SIMPLE_TYPES];
+thread_local const Type *Type::simple_types[MAX_SIMPLE_TYPES];
 
-Type *Type::void_type = NULL;
+thread_local Type *Type::void_type = NULL;
 
 // ---------------------------------------------------------------------
 // List of all types used in the program
-static vector<Type *> AllTypes;
-static vector<Type *> derived_types;
+static thread_local vector<Type *> AllTypes;
+static thread_local vector<Type *> derived_types;
+static thread_local unsigned int struct_sequence = 0;	// ids of struct/union types
 
-AttributeGenerator struct_type_attr_generator;
-AttributeGenerator union_type_attr_generator;
+thread_local AttributeGenerator struct_type_attr_generator;
+thread_local AttributeGenerator union_type_attr_generator;
 
 //////////////////////////////////////////////////////////////////////
 
@@ -102,9 +103,13 @@ public:
 
 	virtual bool filter(int v) const;
 
+	virtual bool admissible(unsigned int n, std::vector<unsigned int> &values) const;
+
 	Type *get_type();
 
 private:
+	bool rejects(const Type *type) const;
+
 	mutable Type *typ_;
 
 };
@@ -120,12 +125,26 @@ NonVoidTypeFilter::~NonVoidTypeFilter()
 
 }
 
+bool
+NonVoidTypeFilter::rejects(const Type *type) const
+{
+	if (type->eType == eSimple && type->simple_type == eVoid)
+		return true;
+
+	if (type->eType == eSimple) {
+		Filter *filter = SIMPLE_TYPES_PROB_FILTER;
+		return filter->filter(type->simple_type);
+	}
+
+	return false;
+}
+
 bool
 NonVoidTypeFilter::filter(int v) const
 {
 	assert(static_cast<unsigned int>(v) < AllTypes.size());
 	Type *type = AllTypes[v];
-	if (type->eType == eSimple && type->simple_type == eVoid)
+	if (rejects(type))
 		return true;
 
 	if (!type->used) {
@@ -134,14 +153,20 @@ NonVoidTypeFilter::filter(int v) const
 	}
 
 	typ_ = type;
-	if (type->eType == eSimple) {
-		Filter *filter = SIMPLE_TYPES_PROB_FILTER;
-		return filter->filter(typ_->simple_type);
-	}
-
 	return false;
 }
 
+bool
+NonVoidTypeFilter::admissible(unsigned int n, std::vector<unsigned int> &values) const
+{
+	assert(n <= AllTypes.size());
+	for (unsigned int v = 0; v < n; v++) {
+		if (!rejects(AllTypes[v]))
+			values.push_back(v);
+	}
+	return true;
+}
+
 Type *
 NonVoidTypeFilter::get_type()
 {
@@ -158,9 +183,13 @@ public:
 
 	virtual bool filter(int v) const;
 
+	virtual bool admissible(unsigned int n, std::vector<unsigned int> &values) const;
+
 	Type *get_type();
 
 private:
+	bool rejects(const Type *type) const;
+
 	mutable Type *typ_;
 
 };
@@ -177,10 +206,8 @@ NonVoidNonVolatileTypeFilter::~NonVoidNonVolatileTypeFilter()
 }
 
 bool
-NonVoidNonVolatileTypeFilter::filter(int v) const
+NonVoidNonVolatileTypeFilter::rejects(const Type *type) const
 {
-	assert(static_cast<unsigned int>(v) < AllTypes.size());
-	Type *type = AllTypes[v];
 	if (type->eType == eSimple && type->simple_type == eVoid)
 		return true;
 
@@ -195,20 +222,42 @@ NonVoidNonVolatileTypeFilter::filter(int v) const
 		return true;
 	}
 
+	if (type->eType == eSimple) {
+		Filter *filter = SIMPLE_TYPES_PROB_FILTER;
+		return filter->filter(type->simple_type);
+	}
+
+	return false;
+}
+
+bool
+NonVoidNonVolatileTypeFilter::filter(int v) const
+{
+	assert(static_cast<unsigned int>(v) < AllTypes.size());
+	Type *type = AllTypes[v];
+	if (rejects(type))
+		return true;
+
 	if (!type->used) {
 		Bookkeeper::record_type_with_bitfields(type);
 		type->used = true;
 	}
 
 	typ_ = type;
-	if (type->eType == eSimple) {
-		Filter *filter = SIMPLE_TYPES_PROB_FILTER;
-		return filter->filter(typ_->simple_type);
-	}
-
 	return false;
 }
 
+bool
+NonVoidNonVolatileTypeFilter::admissible(unsigned int n, std::vector<unsigned int> &values) const
+{
+	assert(n <= AllTypes.size());
+	for (unsigned int v = 0; v < n; v++) {
+		if (!rejects(AllTypes[v]))
+			values.push_back(v);
+	}
+	return true;
+}
+
 Type *
 NonVoidNonVolatileTypeFilter::get_type()
 {
@@ -225,11 +274,15 @@ public:
 
 	virtual bool filter(int v) const;
 
+	virtual bool admissible(unsigned int n, std::vector<unsigned int> &values) const;
+
 	Type *get_type();
 
 	bool for_field_var_;
 	bool struct_has_assign_ops_;
 private:
+	bool rejects(const Type *type) const;
+
 	mutable Type *typ_;
 };
 
@@ -246,31 +299,50 @@ ChooseRandomTypeFilter::~ChooseRandomTypeFilter()
 }
 
 bool
-ChooseRandomTypeFilter::filter(int v) const
+ChooseRandomTypeFilter::rejects(const Type *type) const
 {
-	assert((v >= 0) && (static_cast<unsigned int>(v) < AllTypes.size()));
-	typ_ = AllTypes[v];
-	assert(typ_);
-	if (typ_->eType == eSimple) {
+	assert(type);
+	if (type->eType == eSimple) {
 		Filter *filter = SIMPLE_TYPES_PROB_FILTER;
-		return filter->filter(typ_->simple_type);
+		return filter->filter(type->simple_type);
 	}
-	else if ((typ_->eType == eStruct) && (!CGOptions::return_structs())) {
+	else if ((type->eType == eStruct) && (!CGOptions::return_structs())) {
 		return true;
 	}
 
 	// Struct without assignment ops can not be made a field of a struct with assign ops 
 	// with current implementation of these ops
-    if (for_field_var_ && struct_has_assign_ops_ && !typ_->has_assign_ops()) {
+    if (for_field_var_ && struct_has_assign_ops_ && !type->has_assign_ops()) {
 		assert(CGOptions::lang_cpp());
 		return true;
 	}
-	if (for_field_var_ && typ_->get_struct_depth() >= CGOptions::max_nested_struct_level()) {
+	if (for_field_var_ && type->get_struct_depth() >= CGOptions::max_nested_struct_level()) {
 		return true;
 	}
 	return false;
 }
 
+bool
+ChooseRandomTypeFilter::filter(int v) const
+{
+	assert((v >= 0) && (static_cast<unsigned int>(v) < AllTypes.size()));
+	if (rejects(AllTypes[v]))
+		return true;
+	typ_ = AllTypes[v];
+	return false;
+}
+
+bool
+ChooseRandomTypeFilter::admissible(unsigned int n, std::vector<unsigned int> &values) const
+{
+	assert(n <= AllTypes.size());
+	for (unsigned int v = 0; v < n; v++) {
+		if (!rejects(AllTypes[v]))
+			values.push_back(v);
+	}
+	return true;
+}
+
 Type *
 ChooseRandomTypeFilter::get_type()
 {
@@ -332,12 +404,11 @@ Type::Type(vector<const Type*>& struct_fields, bool isStruct, bool packed,
     qfers_(qfers),
     bitfields_length_(fields_length)
 {
-    static unsigned int sequence = 0;
 	if (isStruct)
         eType = eStruct;
     else
         eType = eUnion;
-    sid =  sequence++;
+    sid =  struct_sequence++;
 }
 
 // --------------------------------------------------------------
@@ -384,17 +455,8 @@ Type::operator=(const Type& t)
 const Type &
 Type::get_simple_type(eSimpleType st)
 {
-	static bool inited = false;
-
 	assert(st != MAX_SIMPLE_TYPES);
 
-	if (!inited) {
-		for (int i = 0; i < MAX_SIMPLE_TYPES; ++i) {
-			Type::simple_types[i] = 0;
-		}
-		inited = true;
-	}
-
 	if (Type::simple_types[st] == 0) {
 		// find if type is in the allTypes already (most likely only "eVoid" is not there)
 		for (size_t i=0; i<AllTypes.size(); i++) {
@@ -1249,6 +1311,7 @@ Type::GenerateSimpleTypes(void)
 void
 GenerateAllTypes(void)
 {
+	RandomStreamScope stream(rsTypes);
 	InitializeTypeAttributes();
 	// In the exhaustive mode, we want to generate all type first.
 	// We don't support struct for now
@@ -1979,8 +2042,17 @@ void OutputStructUnion(Type* type, std::ostream &out)
 void
 OutputStructUnionDeclarations(std::ostream &out)
 {
-    size_t i;
     output_comment_line(out, "--- Struct/Union Declarations ---");
+    OutputNewStructUnions(out);
+}
+
+// ---------------------------------------------------------------------
+/* print the used struct definitions that are not printed yet
+ *************************************************************/
+void
+OutputNewStructUnions(std::ostream &out)
+{
+    size_t i;
     for (i=0; i<AllTypes.size(); i++)
     {
         Type* t = AllTypes[i];
@@ -2036,6 +2108,15 @@ Type::doFinalization(void)
 	for(j = derived_types.begin(); j != derived_types.end(); ++j)
 		delete (*j);
 	derived_types.clear();
+
+	for (int i = 0; i < MAX_SIMPLE_TYPES; ++i) {
+		Type::simple_types[i] = 0;
+	}
+	delete Type::void_type;
+	Type::void_type = NULL;
+	struct_sequence = 0;
+	struct_type_attr_generator.clear();
+	union_type_attr_generator.clear();
 }
 
 
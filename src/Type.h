@@ -292,11 +292,11 @@ public:
 					// need of struct's level type qualifiers.
 	vector<int> bitfields_length_;		// -1 means it's a regular field
 
-	static Type *void_type;
+	static thread_local Type *void_type;
 private:
 	DISALLOW_COPY_AND_ASSIGN(Type);
 
-	static const Type *simple_types[MAX_SIMPLE_TYPES];
+	static thread_local const Type *simple_types[MAX_SIMPLE_TYPES];
 
 	// Package init.
 	friend void GenerateAllTypes(void);
@@ -305,6 +305,7 @@ private:
 void GenerateAllTypes(void);
 const Type * get_int_type(void);
 void OutputStructUnionDeclarations(std::ostream &);
+void OutputNewStructUnions(std::ostream &);
 void OutputStructAssignOps(Type* type, std::ostream &out, bool vol);
 void OutputStructUnion(Type* type, std::ostream &out);
 
@@ -73,13 +73,15 @@
 
 
 using namespace std;
-std::vector< std::vector<const Variable*>* > Variable::ctrl_vars_vectors;
-unsigned long Variable::ctrl_vars_count;
+thread_local std::vector< std::vector<const Variable*>* > Variable::ctrl_vars_vectors;
+thread_local unsigned long Variable::ctrl_vars_count;
+int Variable::static_vars_count = 0;
+thread_local int Variable::vars_count = Variable::static_vars_count;
 
 const char Variable::sink_var_name[] = "csmith_sink_";
 
-bool Variable::var_attr_generate = false;
-AttributeGenerator Variable::var_attr_generator;
+thread_local bool Variable::var_attr_generate = false;
+thread_local AttributeGenerator Variable::var_attr_generator;
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -454,7 +456,8 @@ Variable::Variable(const std::string &name, const Type *type,
 	  isAuto(isAuto), isStatic(isStatic), isRegister(isRegister),
 	  isBitfield_(isBitfield), isAddrTaken(false), isAccessOnce(false),
 	  field_var_of(isFieldVarOf), isArray(false),
-	  qfer(isConsts, isVolatiles)
+	  qfer(isConsts, isVolatiles),
+	  id(vars_count++)
 {
 	// nothing else to do
 }
@@ -468,7 +471,8 @@ Variable::Variable(const std::string &name, const Type *type, const Expression*
 	  isAuto(false), isStatic(false), isRegister(false), isBitfield_(false),
 	  isAddrTaken(false), isAccessOnce(false),
 	  field_var_of(0), isArray(false),
-	  qfer(*qfer)
+	  qfer(*qfer),
+	  id(vars_count++)
 {
 	// nothing else to do
 }
@@ -480,7 +484,8 @@ Variable::Variable(const std::string &name, const Type *type, const Expression*
 	  isAddrTaken(false), isAccessOnce(false),
 	  field_var_of(isFieldVarOf),
 	  isArray(isArray),
-	  qfer(*qfer)
+	  qfer(*qfer),
+	  id(vars_count++)
 {
 	// nothing else to do
 }
@@ -878,6 +883,8 @@ Variable::doFinalization(void)
 		delete v;
 	}
 	ctrl_vars_vectors.clear();
+	ctrl_vars_count = 0;
+	vars_count = static_vars_count;
 }
 
 // --------------------------------------------------------------
@@ -1012,17 +1019,17 @@ Variable::hash(std::ostream& out) const
                 Output(out);
                 out << ", sizeof(";
                 Output(out);
-                out << "), \"" << name << "\", print_hash_value);" << endl;
+                out << "), \"" << name << "\", print_hash_value);" << '\n';
             } else {
                 out << "    transparent_crc(";
                 Output(out);
-                out << ", \"" << name << "\", print_hash_value);" << endl;
+                out << ", \"" << name << "\", print_hash_value);" << '\n';
             }
 		}
 		else {
 			out << "    " << Variable::sink_var_name << " = ";
 			Output(out);
-			out << ";" << endl;
+			out << ";" << '\n';
 		}
     }
 	else if (type->eType == ePointer) {
@@ -1105,7 +1112,7 @@ Variable::output_runtime_value(ostream &out, string prefix, string suffix, int i
 
 	output_tab(out, indent);
 	if (multi_lines) {
-		out << "printf(\"" << prefix << "\");" << endl;
+		out << "printf(\"" << prefix << "\");" << '\n';
 		output_tab(out, indent);
 		out << "printf(\"" << directive << suffix << "\", " << to_string() <<");";
 	}
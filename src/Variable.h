@@ -157,13 +157,14 @@ public:
 	const Variable* field_var_of; //expanded from a struct/union
 	const bool isArray;
 	const CVQualifiers qfer;
+	const int id;	// dense id of every variable ever created, see Effect
 	static std::vector<const Variable*> &get_new_ctrl_vars();
 	static std::vector<const Variable*> &get_last_ctrl_vars();
 
 	static const char sink_var_name[];
 
-	static bool var_attr_generate;
-	static AttributeGenerator var_attr_generator;
+	static thread_local bool var_attr_generate;
+	static thread_local AttributeGenerator var_attr_generator;
 
 private:
 	Variable(const std::string &name, const Type *type, const Expression* init, const CVQualifiers* qfer);
@@ -173,8 +174,12 @@ private:
 			 bool isAuto, bool isStatic, bool isRegister, bool isBitfield, const Variable* isFieldVarOf);
 
 	static std::vector<const Variable*>& new_ctrl_vars(void);
-	static std::vector< std::vector<const Variable*>* > ctrl_vars_vectors;
-	static unsigned long ctrl_vars_count;
+	static thread_local std::vector< std::vector<const Variable*>* > ctrl_vars_vectors;
+	static thread_local unsigned long ctrl_vars_count;
+	static thread_local int vars_count;
+	// ids below this belong to the dummy variables shared by all programs
+	// (and threads), the ids of each program start from here
+	static int static_vars_count;
 
 	void create_field_vars(const Type* type);
 };
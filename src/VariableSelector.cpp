@@ -65,6 +65,7 @@
 #include "Probabilities.h"
 #include "ProbabilityTable.h"
 #include "StringUtils.h"
+#include "Profiler.h"
 
 using namespace std;
 
@@ -72,10 +73,10 @@ using namespace std;
 
 // --------------------------------------------------------------
 // static variables
-vector<Variable*> VariableSelector::AllVars;
-vector<Variable*> VariableSelector::GlobalList;
-vector<Variable*> VariableSelector::GlobalNonvolatilesList;
-bool VariableSelector::var_created = false;
+thread_local vector<Variable*> VariableSelector::AllVars;
+thread_local vector<Variable*> VariableSelector::GlobalList;
+thread_local vector<Variable*> VariableSelector::GlobalNonvolatilesList;
+thread_local bool VariableSelector::var_created = false;
 
 class VariableSelectFilter : public Filter
 {
@@ -113,7 +114,7 @@ VariableSelectFilter::filter(int v) const
 	return false;
 }
 
-ProbabilityTable<unsigned int, eVariableScope> *VariableSelector::scopeTable_ = NULL;
+thread_local ProbabilityTable<unsigned int, eVariableScope> *VariableSelector::scopeTable_ = NULL;
 
 void
 VariableSelector::InitScopeTable()
@@ -310,6 +311,10 @@ VariableSelector::is_eligible_var(const Variable* var, int deref_level, Effect::
 bool
 VariableSelector::has_eligible_volatile_var(const vector<Variable *>& vars, const Type* type, const CVQualifiers* qfer, Effect::Access access, const CGContext& cg_context)
 {
+	// see is_eligible_var: no volatile is eligible in a context with side effects
+	if (!cg_context.get_effect_context().is_side_effect_free()) {
+		return false;
+	}
 	for (size_t i=0; i<vars.size(); i++) {
 		Variable* var = vars[i];
 		if (type && !type->match(var->type, eFlexible)) {
@@ -318,8 +323,12 @@ VariableSelector::has_eligible_volatile_var(const vector<Variable *>& vars, cons
 		if (qfer && !qfer->match_indirect(var->qfer)) {
 			continue;
 		}
+		// the volatile test is cheap, the eligibility test is not
+		if (!var->is_volatile()) {
+			continue;
+		}
 		int deref_level = var->type->get_indirect_level() - type->get_indirect_level();
-		if (is_eligible_var(var, deref_level, access, cg_context) && var->is_volatile()) {
+		if (is_eligible_var(var, deref_level, access, cg_context)) {
 			Bookkeeper::volatile_avail++;
 			return true;
 		}
@@ -512,23 +521,28 @@ VariableSelector::create_and_initialize(Effect::Access access, const CGContext &
 	const Expression* init = NULL;
 	Variable* var = NULL;
 
-	if (rnd_flipcoin(NewArrayVariableProb)) {
+	bool is_array = rnd_flipcoin(NewArrayVariableProb);
+	ERROR_GUARD(NULL);
+	if (is_array) {
 		if (CGOptions::strict_const_arrays()) {
 			init = Constant::make_random(t);
 		} else {
 			init = make_init_value(access, cg_context, t, qfer, blk);
 		}
+		ERROR_GUARD(NULL);
 		var = create_array_and_itemize(blk, name, cg_context, t, init, qfer);
 	}
 	else {
 		init = make_init_value(access, cg_context, t, qfer, blk);
+		ERROR_GUARD(NULL);
 		var = new_variable(name, t, init, qfer);
 	}
+	ERROR_GUARD(NULL);
 	assert(var);
 	return var;
 }
 
-static int tmp_count = 0;
+static thread_local int tmp_count = 0;
 // --------------------------------------------------------------
  /* Parameter "type"
  * 0 --- To generate any type
@@ -546,6 +560,7 @@ VariableSelector::GenerateNewGlobal(Effect::Access access, const CGContext &cg_c
 	string name = RandomGlobalName();
 	tmp_count++;
 	Variable* var = create_and_initialize(access, cg_context, t, &var_qfer, 0, name);
+	ERROR_GUARD(NULL);
 
 	GlobalList.push_back(var);
 	// for DFA
@@ -926,6 +941,7 @@ VariableSelector::GenerateNewParentLocal(Block &block,
 	string name = RandomLocalName();
 
 	Variable* var = create_and_initialize(access, cg_context, t, &var_qfer, blk, name);
+	ERROR_GUARD(NULL);
 	blk->local_vars.push_back(var);
 	FactMgr* fm = get_fact_mgr(&cg_context);
 	fm->add_new_var_fact_and_update_inout_maps(blk, var->get_collective());
@@ -1184,6 +1200,7 @@ VariableSelector::select(Effect::Access access,
 			   const vector<const Variable*>& invalid_vars,
 			   eMatchType mt, eVariableScope scope)
 {
+	ProfileScope profile_scope(Profiler::pSelectVariable);
 	DEPTH_GUARD_BY_TYPE_RETURN_WITH_FLAG(dtSelectVariable, scope, NULL);
 	VariableSelectFilter filter(cg_context);
 	if (scope == MAX_VAR_SCOPE) {
@@ -1256,6 +1273,7 @@ VariableSelector::select_deref_pointer(Effect::Access access, const CGContext &c
 	vars.insert(vars.end(), f->param.begin(), f->param.end());
 
 	Variable* var = choose_var(vars, access, cg_context, type, qfer, eDereference, invalid_vars);
+	ERROR_GUARD(NULL);
 	if (var == 0) {
 		Type* ptr_type = 0;
 		if (type->get_indirect_level() < CGOptions::max_indirect_level()) {
@@ -1352,6 +1370,7 @@ VariableSelector::create_random_array(const CGContext& cg_context)
 
 	Expression* init = Constant::make_random(type);
 	ArrayVariable* av = ArrayVariable::CreateArrayVariable(cg_context, blk, name, type, init, &qfer, NULL);
+	ERROR_GUARD(NULL);
 	AllVars.push_back(av);
 
 	// make the points-to fact known to DFA
@@ -1524,6 +1543,7 @@ VariableSelector::make_dummy_static_variable(const string &name)
 {
 	CVQualifiers dummy;
 	Variable *var = new Variable(name, 0, 0, &dummy);
+	Variable::static_vars_count = Variable::vars_count;
 	return var;
 }
 
@@ -1554,6 +1574,8 @@ VariableSelector::doFinalization(void)
 	AllVars.clear();
 	GlobalList.clear();
 	GlobalNonvolatilesList.clear();
+	var_created = false;
+	tmp_count = 0;
 }
 
 // --------------------------------------------------------------
@@ -42,10 +42,11 @@
 #include "Filter.h"
 #include "CGOptions.h"
 #include "AbsProgramGenerator.h"
+#include "OutputMgr.h"
 
 std::string get_prefixed_name(const std::string &name)
 {
-	if (!CGOptions::prefix_name())
+	if (!CGOptions::prefix_name() || OutputMgr::canonical_output())
 		return name;
 	if (!CGOptions::sequence_name_prefix()) {
 		AbsProgramGenerator* instance = AbsProgramGenerator::GetInstance();
@@ -33,6 +33,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <string>
+#include "AbsRndNumGenerator.h"
 
 class Filter;
 
@@ -57,6 +58,19 @@ void		get_sequence(std::string &sequence);
 unsigned int*   rnd_shuffle(unsigned int n);
 #endif
 
+// Draw from the given stream of random numbers while in scope
+class RandomStreamScope
+{
+public:
+	explicit RandomStreamScope(RandomStream stream)
+		: old_(AbsRndNumGenerator::select_stream(stream)) {}
+
+	~RandomStreamScope(void) { AbsRndNumGenerator::select_stream(old_); }
+
+private:
+	RandomStream old_;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #endif // RANDOM_H
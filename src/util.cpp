@@ -48,7 +48,7 @@
 using namespace std;
 ///////////////////////////////////////////////////////////////////////////////
 
-static int gensym_count = 0;
+static thread_local int gensym_count = 0;
 
 void
 reset_gensym()
@@ -80,7 +80,7 @@ gensym(const string& basename)
 	return ss.str();
 }
 
-static std::string errlog;
+static thread_local std::string errlog;
 
 bool log_analysis_fail(std::string msg)
 {